@@ -7,7 +7,50 @@
 #include <Components/CapsuleComponent.h>
 #include "WallrunnableInterface.h"
 #include "CustomMovementModes.h"
+#include "WallRunCollisionChannels.h"
+#include "WallRunProbeSubsystem.h"
+#include "WallRunTelemetry.h"
+#include "WallRunEventBusSubsystem.h"
+#include "WallrunnableRegistrySubsystem.h"
 #include <Kismet/KismetSystemLibrary.h>
+#include <Net/UnrealNetwork.h>
+
+bool FWallRunRepSnapshot::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	/* Pack the side, phase and corner type into a single byte, and the wall normal's yaw and pitch into three more. */
+
+	uint8 Flags = static_cast<uint8>((WallRunSide & 0x3) | (bWallRunInitiated << 2) | (bIsTurningAroundCorner << 3) | ((CornerType & 0x1) << 4));
+	Ar << Flags;
+
+	FRotator WallNormalRotation = WallNormal.Rotation();
+	uint16 CompressedYaw = FRotator::CompressAxisToShort(WallNormalRotation.Yaw);
+	uint8 CompressedPitch = FRotator::CompressAxisToByte(WallNormalRotation.Pitch);
+	Ar << CompressedYaw;
+	Ar << CompressedPitch;
+
+	if (Ar.IsLoading())
+	{
+		WallRunSide = static_cast<EWallRunSide>(Flags & 0x3);
+		bWallRunInitiated = (Flags >> 2) & 0x1;
+		bIsTurningAroundCorner = (Flags >> 3) & 0x1;
+		CornerType = static_cast<ECornerType>((Flags >> 4) & 0x1);
+
+		WallNormalRotation = FRotator(FRotator::DecompressAxisFromByte(CompressedPitch), FRotator::DecompressAxisFromShort(CompressedYaw), 0.0);
+		WallNormal = WallNormalRotation.Vector();
+	}
+
+	bOutSuccess = true;
+	return true;
+}
+
+bool FWallRunRepSnapshot::operator==(const FWallRunRepSnapshot& Other) const
+{
+	return WallRunSide == Other.WallRunSide
+		&& bWallRunInitiated == Other.bWallRunInitiated
+		&& bIsTurningAroundCorner == Other.bIsTurningAroundCorner
+		&& CornerType == Other.CornerType
+		&& WallNormal.Equals(Other.WallNormal, UE_KINDA_SMALL_NUMBER);
+}
 
 
 void UCustomCharacterMovementComponent::BeginPlay()
@@ -16,7 +59,8 @@ void UCustomCharacterMovementComponent::BeginPlay()
 
 	bWantsToWallRun = false;
 	WallSearchTraceDistance = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius() * 2.0;
-	PrevNonWallrunnableActor = nullptr;
+	WallrunnableRegistry = GetWorld()->GetSubsystem<UWallrunnableRegistrySubsystem>();
+	WallRunEventBus = GetWorld()->GetSubsystem<UWallRunEventBusSubsystem>();
 	CharacterOwner->GetCapsuleComponent()->OnComponentHit.AddUniqueDynamic(this, &UCustomCharacterMovementComponent::OnCapsuleHit);
 }
 
@@ -25,6 +69,21 @@ void UCustomCharacterMovementComponent::TickComponent(float DeltaTime, ELevelTic
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	WallRunControlInputVector = {};
+
+	ExpireWallRunCooldowns();
+
+	if (CharacterOwner && CharacterOwner->HasAuthority())
+	{
+		UpdateWallRunRepSnapshot();
+	}
+}
+
+void UCustomCharacterMovementComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	/* The snapshot is refreshed in the same tick as the character's replicated movement and goes out in the same actor channel update. Proxies only use it while the replicated movement mode is wall running. */
+	DOREPLIFETIME_CONDITION(UCustomCharacterMovementComponent, WallRunRepSnapshot, COND_SimulatedOnly);
 }
 
 void UCustomCharacterMovementComponent::AddInputVector(FVector WorldVector, bool bForce)
@@ -49,6 +108,37 @@ bool UCustomCharacterMovementComponent::CanAttemptJump() const
 	return Super::CanAttemptJump();
 }
 
+bool UCustomCharacterMovementComponent::DoJump(bool bReplayingMoves, float DeltaTime)
+{
+	if (!IsWallRunning())
+	{
+		return Super::DoJump(bReplayingMoves, DeltaTime);
+	}
+
+	const FVector Forward = UpdatedComponent->GetForwardVector();
+
+	/* Transfer to the wall on the opposite side if there is one. The target only depends on the character's location and the registered geometry, so replayed moves pick the same one. */
+	FVector TransferTargetLocation{};
+
+	if (const UPrimitiveComponent* const TransferTarget = FindWallTransferTarget(TransferTargetLocation))
+	{
+		const FVector ToOppositeWall = FVector::VectorPlaneProject(TransferTargetLocation - UpdatedComponent->GetComponentLocation(), FVector::UpVector).GetSafeNormal();
+
+		Velocity = ToOppositeWall * WallTransferSpeed + Forward * WallRunSpeed;
+		WallTransferTarget = TransferTarget->GetOwner();
+	}
+	else
+	{
+		Velocity = WallRunWallNormal * WallJumpOffSpeed + Forward * WallRunSpeed;
+		WallTransferTarget = nullptr;
+	}
+
+	Velocity.Z = FMath::Max<FVector::FReal>(Velocity.Z, JumpZVelocity);
+	SetMovementMode(MOVE_Falling);
+
+	return true;
+}
+
 bool UCustomCharacterMovementComponent::IsWallRunning() const
 {
 	return MovementMode == MOVE_Custom && CustomMovementMode == CMOVE_WallRunning;
@@ -75,28 +165,17 @@ void UCustomCharacterMovementComponent::WallRunStop()
 
 void UCustomCharacterMovementComponent::OnCapsuleHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
-	/* No need to process an Actor that we've already determined is non-wallrunnable. */
-	if (OtherActor == PrevNonWallrunnableActor) return;
-
-	if (CanWallRun())
+	/* Check if the hit Actor inherits from the IWallrunnableInterface. If so, the Actor can be wall run on. Store the hit result and initiate the wall run */
+	if (CanWallRun(OtherActor) && Cast<IWallrunnableInterface>(OtherActor))
 	{
-		/* Check if the hit Actor inherits from the IWallrunnableInterface. If so, the Actor can be wall run on. Store the hit result and initiate the wall run */
-		if (Cast<IWallrunnableInterface>(OtherActor))
-		{
-			WallRunHitResult = Hit;
-			InitWallRun();
-		}
-		else
-		{
-			/* Store a pointer to this Actor to check again in the future if a hit actor is non-wall runnable.*/
-			PrevNonWallrunnableActor = OtherActor;
-		}
+		WallRunHitResult = Hit;
+		InitWallRun();
 	}
 }
 
-bool UCustomCharacterMovementComponent::CanWallRun() const
+bool UCustomCharacterMovementComponent::CanWallRun(const AActor* Surface) const
 {
-	return (bAutoWallRun || bWantsToWallRun) && IsFalling() && !IsWallRunCooldownActive();
+	return (bAutoWallRun || bWantsToWallRun) && IsFalling() && !IsWallRunCooldownActive(Surface);
 }
 
 void UCustomCharacterMovementComponent::InitWallRun()
@@ -104,13 +183,19 @@ void UCustomCharacterMovementComponent::InitWallRun()
 	WallRunControlInputVector = {};
 	bWallRunInitiated = false;
 	bIsTurningAroundCorner = false;
+	++WallRunProbeGeneration;
 
 	SetMovementMode(MOVE_Custom, CMOVE_WallRunning);
 
 	/* Save what side the wall is relative to the character. */
 	const double RightProjWallNormal = FVector::DotProduct(CharacterOwner->GetActorRightVector(), WallRunHitResult.ImpactNormal);
 	
+	const EWallRunSide PrevWallRunSide = WallRunSide;
 	WallRunSide = (RightProjWallNormal > 0.0) ? EWRS_LeftSide : EWRS_RightSide;
+	WallRunWallNormal = WallRunHitResult.ImpactNormal;
+	NotifiedWallRunWallNormal = WallRunWallNormal;
+	WallRunSurface = WallRunHitResult.GetActor();
+	WallTransferTarget = nullptr;
 
 	FRotator TargetRotation{};
 
@@ -123,6 +208,18 @@ void UCustomCharacterMovementComponent::InitWallRun()
 	const FLatentActionInfo LatentActionInfo{ 0, INDEX_NONE, TEXT("OnWallRunInitComplete"), this };
 	UKismetSystemLibrary::MoveComponentTo(CharacterOwner->GetRootComponent(), CharacterOwner->GetActorLocation(), TargetRotation, true, true, MoveDuration, true, EMoveComponentAction::Move, LatentActionInfo);
 
+	WallRunStartTime = GetWorld()->GetTimeSeconds();
+	WallRunDistance = 0.0;
+	RecordWallRunTelemetry(EWallRunTelemetryEvent::WallRunBegin, WallRunSide);
+
+	PublishWallRunEvent(EWallRunEventType::Entry, WallRunWallNormal);
+
+	if (PrevWallRunSide != EWRS_None && PrevWallRunSide != WallRunSide)
+	{
+		PublishWallRunEvent(EWallRunEventType::SideChange, WallRunWallNormal);
+	}
+
+	OnWallRunBegin.ExecuteIfBound(WallRunWallNormal);
 }
 
 void UCustomCharacterMovementComponent::CalcWallRunRotation(FRotator& OutWallRunRotation)
@@ -131,11 +228,11 @@ void UCustomCharacterMovementComponent::CalcWallRunRotation(FRotator& OutWallRun
 
 	if (WallRunSide == EWRS_LeftSide)
 	{
-		Y = WallRunHitResult.ImpactNormal;
+		Y = WallRunWallNormal;
 	}
 	else
 	{
-		Y = -WallRunHitResult.ImpactNormal;
+		Y = -WallRunWallNormal;
 	}
 
 	const FVector X = FVector::CrossProduct(Y, CharacterOwner->GetActorUpVector()).GetSafeNormal();
@@ -172,7 +269,7 @@ void UCustomCharacterMovementComponent::PhysWallRunning(float deltaTime, int32 I
 	FVector TraceStart = CharacterOwner->GetActorLocation();
 	FVector TraceDirection = CharacterOwner->GetActorForwardVector();
 	FVector TraceEnd = TraceStart + TraceDirection * WallSearchTraceDistance;
-	GetWorld()->LineTraceSingleByChannel(WallRunHitResult, TraceStart, TraceEnd, ECC_Visibility);
+	TraceWallRunProbe(EWRP_Forward, TraceStart, TraceEnd, WallRunHitResult);
 
 	DrawDebugLine(GetWorld(), TraceStart, TraceEnd, FColor::Red, false);
 
@@ -195,10 +292,13 @@ void UCustomCharacterMovementComponent::PhysWallRunning(float deltaTime, int32 I
 
 	TraceEnd = TraceStart + TraceDirection * WallSearchTraceDistance;
 
-	GetWorld()->LineTraceSingleByChannel(WallRunHitResult, TraceStart, TraceEnd, ECC_Visibility);
+	TraceWallRunProbe(EWRP_Side, TraceStart, TraceEnd, WallRunHitResult);
 
 	if (WallRunHitResult.bBlockingHit)
 	{
+		SetWallRunWallNormal(WallRunHitResult.ImpactNormal);
+		WallRunSurface = WallRunHitResult.GetActor();
+
 		/* Move the character close to the wall. Must be done to prevent the character from moving off the intended path when moving at high speeds on curved walls. */
 
 		const FVector ImpactPointToOwner{ CharacterOwner->GetActorLocation() - WallRunHitResult.ImpactPoint };
@@ -214,7 +314,25 @@ void UCustomCharacterMovementComponent::PhysWallRunning(float deltaTime, int32 I
 		Velocity = CharacterOwner->GetActorForwardVector() * WallRunSpeed;
 
 		const FVector AdjustedVelocity = Velocity * deltaTime;
+		const FVector PreMoveLocation = UpdatedComponent->GetComponentLocation();
 		SafeMoveUpdatedComponent(AdjustedVelocity, InterpedTargetRotation, true, WallRunHitResult);
+		WallRunDistance += FVector::Dist(PreMoveLocation, UpdatedComponent->GetComponentLocation());
+
+		/* Wall run probes only see wallrunnable surfaces, so anything else ahead only shows up as a blocked move. Turn around it if it can be wall run on, otherwise end the wall run instead of stalling against it. */
+
+		static constexpr double BlockedMoveNormalThreshold = -0.5;
+
+		if (WallRunHitResult.bBlockingHit && FVector::DotProduct(WallRunHitResult.Normal, Velocity.GetSafeNormal()) < BlockedMoveNormalThreshold)
+		{
+			if (Cast<IWallrunnableInterface>(WallRunHitResult.GetActor()))
+			{
+				HandleWallRunCorner(ECT_Inner);
+			}
+			else
+			{
+				SetMovementMode(EMovementMode::MOVE_Falling);
+			}
+		}
 
 		return;
 	}
@@ -233,7 +351,7 @@ void UCustomCharacterMovementComponent::PhysWallRunning(float deltaTime, int32 I
 	TraceDirection = -CharacterOwner->GetActorForwardVector();
 	TraceEnd = TraceStart + TraceDirection * WallSearchTraceDistance;
 
-	GetWorld()->LineTraceSingleByChannel(WallRunHitResult, TraceStart, TraceEnd, ECC_Visibility);
+	TraceWallRunProbe(EWRP_OuterCorner, TraceStart, TraceEnd, WallRunHitResult);
 
 	if (WallRunHitResult.bBlockingHit)
 	{
@@ -250,28 +368,147 @@ void UCustomCharacterMovementComponent::OnMovementModeChanged(EMovementMode Prev
 
 	if (PreviousMovementMode == EMovementMode::MOVE_Custom && PreviousCustomMode == CMOVE_WallRunning)
 	{
-		GetWorld()->GetTimerManager().SetTimer(WallRunCooldownTimer, WallRunCooldownDuration, false);
+		/* Simulated proxies enter wall runs through replication without running InitWallRun, so only the machine that started the run records and publishes its end. */
+		if (WallRunStartTime >= 0.0)
+		{
+			StartWallRunCooldown(WallRunSurface.Get());
+
+			RecordWallRunTelemetry(EWallRunTelemetryEvent::WallRunEnd, WallRunSide, GetWorld()->GetTimeSeconds() - WallRunStartTime, WallRunDistance);
+			RecordWallRunTelemetry(EWallRunTelemetryEvent::CooldownBegin, 0, WallRunCooldownDuration);
+
+			PublishWallRunEvent(EWallRunEventType::Exit, WallRunWallNormal);
+
+			WallRunStartTime = -1.0;
+		}
+
+		OnWallRunEnd.ExecuteIfBound();
+	}
+
+	/* A transfer only applies to the jump that started it. */
+	if (!IsFalling() && !IsWallRunning())
+	{
+		WallTransferTarget = nullptr;
+	}
+}
+
+bool UCustomCharacterMovementComponent::IsWallRunCooldownActive(const AActor* Surface) const
+{
+	/* The wall that the character is deliberately transferring to can always be wall run on. */
+	if (Surface && Surface == WallTransferTarget.Get()) return false;
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	for (const FWallRunSurfaceCooldown& SurfaceCooldown : WallRunSurfaceCooldowns)
+	{
+		if (SurfaceCooldown.Surface.Get() == Surface && SurfaceCooldown.EndTime > CurrentTime)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UCustomCharacterMovementComponent::StartWallRunCooldown(const AActor* Surface)
+{
+	/* A cooldown that has ended but hasn't been removed yet must not be extended, as its surface already left cooldown. */
+	ExpireWallRunCooldowns();
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	const double EndTime = CurrentTime + WallRunCooldownDuration;
+
+	for (FWallRunSurfaceCooldown& SurfaceCooldown : WallRunSurfaceCooldowns)
+	{
+		if (SurfaceCooldown.Surface.Get() == Surface)
+		{
+			SurfaceCooldown.EndTime = EndTime;
+			return;
+		}
+	}
+
+	WallRunSurfaceCooldowns.Add({ Surface, CurrentTime, EndTime, FVector3f(UpdatedComponent->GetComponentLocation()) });
+}
+
+const UPrimitiveComponent* UCustomCharacterMovementComponent::FindWallTransferTarget(FVector& OutTargetLocation) const
+{
+	if (!WallrunnableRegistry) return nullptr;
+
+	/* Only walls within this angle of the current wall's normal count as being on the opposite side. */
+	static const double MinTransferDirectionDot = FMath::Cos(FMath::DegreesToRadians(45.0));
+
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const FVector AwayFromWall = WallRunWallNormal.GetSafeNormal2D();
+
+	TArray<UPrimitiveComponent*> NearbySurfaces;
+	WallrunnableRegistry->QueryNearby(Location, WallTransferMaxDistance, NearbySurfaces);
+
+	const UPrimitiveComponent* TransferTarget = nullptr;
+	double TransferTargetDistanceSquared = FMath::Square(WallTransferMaxDistance);
+
+	for (const UPrimitiveComponent* const Surface : NearbySurfaces)
+	{
+		const AActor* const SurfaceActor = Surface->GetOwner();
+
+		if (SurfaceActor == WallRunSurface.Get() || !Cast<IWallrunnableInterface>(SurfaceActor)) continue;
+
+		/* The closest point on the surface's own collision shapes, which doesn't need a scene query. */
+		FVector ClosestPoint{};
+
+		if (Surface->GetClosestPointOnCollision(Location, ClosestPoint) <= 0.0f) continue;
+
+		const FVector ToClosestPoint = FVector::VectorPlaneProject(ClosestPoint - Location, FVector::UpVector);
+		const double DistanceSquared = ToClosestPoint.SizeSquared();
+
+		if (DistanceSquared >= TransferTargetDistanceSquared || FVector::DotProduct(ToClosestPoint, AwayFromWall) < MinTransferDirectionDot * FMath::Sqrt(DistanceSquared)) continue;
+
+		TransferTarget = Surface;
+		TransferTargetDistanceSquared = DistanceSquared;
+		OutTargetLocation = ClosestPoint;
 	}
+
+	return TransferTarget;
 }
 
-bool UCustomCharacterMovementComponent::IsWallRunCooldownActive() const
+void UCustomCharacterMovementComponent::ExpireWallRunCooldowns()
 {
-	return GetWorld()->GetTimerManager().IsTimerActive(WallRunCooldownTimer);
+	if (WallRunSurfaceCooldowns.IsEmpty()) return;
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	for (int32 Index = WallRunSurfaceCooldowns.Num() - 1; Index >= 0; --Index)
+	{
+		const FWallRunSurfaceCooldown& SurfaceCooldown = WallRunSurfaceCooldowns[Index];
+
+		if (SurfaceCooldown.EndTime <= CurrentTime)
+		{
+			RecordWallRunTelemetry(EWallRunTelemetryEvent::CooldownEnd, SurfaceCooldown.StartLocation, 0, SurfaceCooldown.EndTime - SurfaceCooldown.StartTime);
+
+			WallRunSurfaceCooldowns.RemoveAtSwap(Index, EAllowShrinking::No);
+			OnWallRunCooldownExpired();
+		}
+	}
 }
 
 void UCustomCharacterMovementComponent::HandleWallRunCorner(const ECornerType CornerType)
 {
+	WallRunWallNormal = WallRunHitResult.ImpactNormal;
+	WallRunSurface = WallRunHitResult.GetActor();
+	CornerTurnType = CornerType;
+
 	FRotator TargetRotation{};
 	CalcWallRunRotation(TargetRotation);
 
 	const FVector CornerTurnDirection = FRotationMatrix(TargetRotation).GetUnitAxis(EAxis::X);
 	const bool bPlayerWantsToTurn = FVector::DotProduct(CornerTurnDirection, WallRunControlInputVector) > 0.0;
 
+	RecordWallRunTelemetry(EWallRunTelemetryEvent::CornerTurnBegin, CornerType, bPlayerWantsToTurn ? 1.0f : 0.0f);
+
 	if (bPlayerWantsToTurn)
 	{
 		bIsTurningAroundCorner = true;
 
 		OnCornerTurnBegin.ExecuteIfBound(CornerTurnDirection, CornerType);
+		PublishWallRunEvent(EWallRunEventType::CornerTurnBegin, CornerTurnDirection);
 
 		const FVector TargetLocation = WallRunHitResult.ImpactPoint + WallRunHitResult.ImpactNormal * CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius();
 
@@ -289,5 +526,194 @@ void UCustomCharacterMovementComponent::HandleWallRunCorner(const ECornerType Co
 void UCustomCharacterMovementComponent::OnTurnedAroundCorner()
 {
 	bIsTurningAroundCorner = false;
+	++WallRunProbeGeneration;
+	NotifiedWallRunWallNormal = WallRunWallNormal;
+	RecordWallRunTelemetry(EWallRunTelemetryEvent::CornerTurnEnd, CornerTurnType);
 	OnCornerTurnEnd.ExecuteIfBound();
+	PublishWallRunEvent(EWallRunEventType::CornerTurnEnd, WallRunWallNormal);
+}
+
+bool UCustomCharacterMovementComponent::TraceWallRunProbe(const EWallRunProbe Probe, const FVector& Start, const FVector& End, FHitResult& OutHit)
+{
+	/* Cached results older than this many frames are considered too stale to move the character with. */
+	static constexpr uint64 MaxProbeResultAge = 4;
+
+	FWallRunProbeCache& ProbeCache = WallRunProbeCache[Probe];
+	UWallRunProbeSubsystem* const ProbeSubsystem = CanUseWallProbeScheduler() ? GetWorld()->GetSubsystem<UWallRunProbeSubsystem>() : nullptr;
+
+	if (ProbeSubsystem)
+	{
+		/* A synchronous fallback trace already refreshes the cache, so only queue the probe when the cached result is used instead. */
+		if (ProbeCache.Generation == WallRunProbeGeneration && GFrameCounter - ProbeCache.FrameNumber <= MaxProbeResultAge)
+		{
+			ProbeSubsystem->SubmitProbe(this, Probe, WallRunProbeGeneration, Start, End);
+
+			OutHit = ProbeCache.Hit;
+			return OutHit.bBlockingHit;
+		}
+	}
+
+	const double TraceStartTime = FPlatformTime::Seconds();
+
+	GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECC_WallRun);
+
+	/* Fallback traces for probes that the scheduler couldn't fit in are taken out of its budget, so they can't add up to more than it. */
+	if (ProbeSubsystem)
+	{
+		ProbeSubsystem->ChargeSynchronousProbe(FPlatformTime::Seconds() - TraceStartTime);
+	}
+
+	ProbeCache.Hit = OutHit;
+	ProbeCache.Generation = WallRunProbeGeneration;
+	ProbeCache.FrameNumber = GFrameCounter;
+
+	return OutHit.bBlockingHit;
+}
+
+bool UCustomCharacterMovementComponent::CanUseWallProbeScheduler() const
+{
+	if (!bUseWallProbeScheduler || bClientUpdating || !CharacterOwner) return false;
+
+	/* The owning client and the server have to reach the same corner and exit decisions for every move, or the client gets corrected. */
+	const ENetRole LocalRole = CharacterOwner->GetLocalRole();
+
+	return LocalRole != ROLE_AutonomousProxy && !(LocalRole == ROLE_Authority && CharacterOwner->GetRemoteRole() == ROLE_AutonomousProxy);
+}
+
+bool UCustomCharacterMovementComponent::IsApproachingCorner() const
+{
+	const FWallRunProbeCache& ForwardProbeCache = WallRunProbeCache[EWRP_Forward];
+	const FWallRunProbeCache& SideProbeCache = WallRunProbeCache[EWRP_Side];
+
+	const bool bForwardProbeHit = ForwardProbeCache.Generation == WallRunProbeGeneration && ForwardProbeCache.Hit.bBlockingHit;
+	const bool bSideProbeMissed = SideProbeCache.Generation == WallRunProbeGeneration && !SideProbeCache.Hit.bBlockingHit;
+
+	return bForwardProbeHit || bSideProbeMissed;
+}
+
+void UCustomCharacterMovementComponent::ReceiveWallRunProbeResult(const EWallRunProbe Probe, const uint32 Generation, const uint64 FrameNumber, const FHitResult& Hit)
+{
+	FWallRunProbeCache& ProbeCache = WallRunProbeCache[Probe];
+
+	/* Ignore results for an outdated generation, or results older than what a synchronous fallback trace already cached. */
+	if (Generation != WallRunProbeGeneration || FrameNumber < ProbeCache.FrameNumber) return;
+
+	ProbeCache.Hit = Hit;
+	ProbeCache.Generation = Generation;
+	ProbeCache.FrameNumber = FrameNumber;
+}
+
+void UCustomCharacterMovementComponent::SimulateMovement(float DeltaTime)
+{
+	/* Network updates that change the movement mode, such as the end of a wall run, are applied by the base implementation before it moves the proxy. */
+	if (!IsWallRunning() || WallRunSide == EWRS_None || (bNetworkUpdateReceived && bNetworkMovementModeChanged))
+	{
+		Super::SimulateMovement(DeltaTime);
+		return;
+	}
+
+	if (!HasValidData() || UpdatedComponent->Mobility != EComponentMobility::Movable) return;
+
+	/* Don't simulate relative to a base that hasn't been resolved on this machine yet. */
+	if (CharacterOwner->GetReplicatedBasedMovement().IsBaseUnresolved()) return;
+
+	/* The replicated location and velocity were applied when the update was received, and the movement mode didn't change, so the update is handled. */
+	bNetworkUpdateReceived = false;
+
+	/* Simulated proxies slide along the replicated wall plane without any physics queries. Corner turns are left to the server's location updates. */
+
+	if (!bIsTurningAroundCorner && bWallRunInitiated && DeltaTime >= MIN_TICK_TIME)
+	{
+		Velocity = FVector::VectorPlaneProject(Velocity, WallRunWallNormal);
+
+		FRotator TargetRotation{};
+		CalcWallRunRotation(TargetRotation);
+		const FRotator InterpedTargetRotation = FMath::RInterpTo(UpdatedComponent->GetComponentRotation(), TargetRotation, DeltaTime, WallRunRotationInterpSpeed);
+
+		MoveUpdatedComponent(Velocity * DeltaTime, InterpedTargetRotation, false);
+	}
+
+	UpdateComponentVelocity();
+	bJustTeleported = false;
+
+	LastUpdateLocation = UpdatedComponent->GetComponentLocation();
+	LastUpdateRotation = UpdatedComponent->GetComponentQuat();
+	LastUpdateVelocity = Velocity;
+}
+
+void UCustomCharacterMovementComponent::UpdateWallRunRepSnapshot()
+{
+	const bool bWallRunning = IsWallRunning();
+
+	WallRunRepSnapshot.WallRunSide = bWallRunning ? WallRunSide : EWRS_None;
+	WallRunRepSnapshot.bWallRunInitiated = bWallRunning && bWallRunInitiated;
+	WallRunRepSnapshot.bIsTurningAroundCorner = bWallRunning && bIsTurningAroundCorner;
+	WallRunRepSnapshot.CornerType = CornerTurnType;
+	WallRunRepSnapshot.WallNormal = bWallRunning ? WallRunWallNormal : FVector::ZeroVector;
+}
+
+void UCustomCharacterMovementComponent::OnRep_WallRunRepSnapshot()
+{
+	WallRunSide = WallRunRepSnapshot.WallRunSide;
+	bWallRunInitiated = WallRunRepSnapshot.bWallRunInitiated;
+	bIsTurningAroundCorner = WallRunRepSnapshot.bIsTurningAroundCorner;
+	CornerTurnType = WallRunRepSnapshot.CornerType;
+	SetWallRunWallNormal(WallRunRepSnapshot.WallNormal);
+}
+
+void UCustomCharacterMovementComponent::SetWallRunWallNormal(const FVector& WallNormal)
+{
+	WallRunWallNormal = WallNormal;
+
+	if (!IsWallRunning() || bIsTurningAroundCorner) return;
+
+	/* Corner turns notify through OnCornerTurnEnd instead, and small changes are ignored so curved walls don't notify every frame. */
+	if (FVector::DotProduct(WallRunWallNormal, NotifiedWallRunWallNormal) >= FMath::Cos(FMath::DegreesToRadians(WallRunNormalChangeNotifyAngle))) return;
+
+	NotifiedWallRunWallNormal = WallRunWallNormal;
+	OnWallRunWallNormalChanged.ExecuteIfBound(WallRunWallNormal);
+}
+
+void UCustomCharacterMovementComponent::RecordWallRunTelemetry(const EWallRunTelemetryEvent Event, const uint8 Detail, const float Value0, const float Value1) const
+{
+	if (!FWallRunTelemetry::IsEnabled()) return;
+
+	RecordWallRunTelemetry(Event, FVector3f(UpdatedComponent->GetComponentLocation()), Detail, Value0, Value1);
+}
+
+void UCustomCharacterMovementComponent::RecordWallRunTelemetry(const EWallRunTelemetryEvent Event, const FVector3f& Location, const uint8 Detail, const float Value0, const float Value1) const
+{
+	if (!FWallRunTelemetry::IsEnabled()) return;
+
+	FWallRunTelemetryRecord Record{};
+	Record.WorldTimeSeconds = GetWorld()->GetTimeSeconds();
+	Record.CharacterId = GetUniqueID();
+	Record.Location = Location;
+	Record.Value0 = Value0;
+	Record.Value1 = Value1;
+	Record.Event = Event;
+	Record.Detail = Detail;
+
+	FWallRunTelemetry::Record(Record);
+}
+
+void UCustomCharacterMovementComponent::OnWallRunCooldownExpired()
+{
+	PublishWallRunEvent(EWallRunEventType::CooldownExpired);
+}
+
+void UCustomCharacterMovementComponent::PublishWallRunEvent(const EWallRunEventType Type, const FVector& Direction) const
+{
+	if (!WallRunEventBus || !WallRunEventBus->HasSubscribers()) return;
+
+	FWallRunEvent Event{};
+	Event.Source = this;
+	Event.WorldTimeSeconds = GetWorld()->GetTimeSeconds();
+	Event.Location = UpdatedComponent->GetComponentLocation();
+	Event.Direction = Direction;
+	Event.Type = Type;
+	Event.WallRunSide = WallRunSide;
+	Event.CornerType = CornerTurnType;
+
+	WallRunEventBus->Publish(Event);
 }
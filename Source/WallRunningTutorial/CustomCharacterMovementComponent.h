@@ -26,10 +26,96 @@ enum ECornerType : uint8
 	ECT_MAX		UMETA(Hidden),
 };
 
+enum class EWallRunTelemetryEvent : uint8;
+enum class EWallRunEventType : uint8;
+class UWallRunEventBusSubsystem;
+class UWallrunnableRegistrySubsystem;
+
+/** Enum identifying each probe that the character performs every frame while wall running. */
+enum EWallRunProbe : uint8
+{
+	EWRP_Forward,
+	EWRP_Side,
+	EWRP_OuterCorner,
+
+	EWRP_MAX,
+};
+
+/** The most recent result of a wall run probe. */
+struct FWallRunProbeCache
+{
+	/** Hit info of the probe. */
+	FHitResult Hit{};
+
+	/** The wall run probe generation that the probe was requested for. A result from an older generation is no longer valid. */
+	uint32 Generation = 0;
+
+	/** The frame number that the probe was requested on. */
+	uint64 FrameNumber = 0;
+};
+
+/** Compact snapshot of the wall run state, replicated to simulated proxies so they can wall run without tracing for walls. */
+USTRUCT()
+struct FWallRunRepSnapshot
+{
+	GENERATED_BODY()
+
+	/** Normal of the wall that the character is running on. Quantized to a yaw and pitch when replicated. */
+	FVector WallNormal{};
+
+	/** Which side of the character the wall is on. */
+	EWallRunSide WallRunSide{ EWRS_None };
+
+	/** The type of the corner that the character is turning around, or turned around last. */
+	ECornerType CornerType{ ECT_Inner };
+
+	/** If true, the character's wall run initiation is complete. */
+	bool bWallRunInitiated = false;
+
+	/** If true, the character is currently turning around a corner. */
+	bool bIsTurningAroundCorner = false;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FWallRunRepSnapshot& Other) const;
+};
+
+template<>
+struct TStructOpsTypeTraits<FWallRunRepSnapshot> : public TStructOpsTypeTraitsBase2<FWallRunRepSnapshot>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+/** A surface that the character recently wall ran on, and can't wall run on again until the cooldown ends. */
+struct FWallRunSurfaceCooldown
+{
+	/** The actor owning the surface that is on cooldown. Surfaces are identified by actor, as wall run probes hit an actor's wall run proxy while capsule hits hit its mesh. */
+	TWeakObjectPtr<const AActor> Surface;
+
+	/** World time that the cooldown started at. Restarting the cooldown before it ends keeps this, as the surface never left cooldown. */
+	double StartTime = 0.0;
+
+	/** World time that the cooldown ends at. */
+	double EndTime = 0.0;
+
+	/** Location of the character when the cooldown started, which telemetry attributes the cooldown to. */
+	FVector3f StartLocation{};
+};
+
 /** Non-dynamic single delegate signature used to notify when the character is beginning to turn around a corner. The first parameter is a vector representing the direction of the corner turn. The second parameter is the corner type that the character is at. */
 DECLARE_DELEGATE_TwoParams(FOnCornerTurnBeginSignature, const FVector& CornerTurnDirection, const ECornerType CornerType);
 /** Non-dynamic single delegate signature used to notify when the character has completed turning around a corner. */
 DECLARE_DELEGATE(FOnCornerTurnEndSignature);
+/** Non-dynamic single delegate signature used to notify when the character has started wall running. The parameter is the normal of the wall. */
+DECLARE_DELEGATE_OneParam(FOnWallRunBeginSignature, const FVector& WallNormal);
+/** Non-dynamic single delegate signature used to notify when the character has stopped wall running. */
+DECLARE_DELEGATE(FOnWallRunEndSignature);
+/** Non-dynamic single delegate signature used to notify when the normal of the wall that the character is running on has noticeably changed, such as along a curved wall. The parameter is the new normal of the wall. */
+DECLARE_DELEGATE_OneParam(FOnWallRunWallNormalChangedSignature, const FVector& WallNormal);
 
 /**
  * UCustomCharacterMovementComponent is an extension of UCharacterMovementComponent that includes a movement mode for wall running.
@@ -49,6 +135,10 @@ public:
 
 	virtual bool CanAttemptJump() const override;
 
+	virtual bool DoJump(bool bReplayingMoves, float DeltaTime) override;
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 	/** Returns true if the character is in the wall running movement mode. */
 	UFUNCTION(BlueprintCallable)
 	bool IsWallRunning() const;
@@ -59,6 +149,15 @@ public:
 	UFUNCTION(BlueprintCallable)
 	FORCEINLINE bool IsTurningAroundCorner() const { return bIsTurningAroundCorner; }
 
+	/** Returns the actor owning the surface that the character is wall running on, or last wall ran on. */
+	FORCEINLINE const AActor* GetWallRunSurface() const { return WallRunSurface.Get(); }
+
+	/** Returns the actor owning the wall that the character is transferring to after jumping off a wall, or null if it isn't transferring. */
+	FORCEINLINE const AActor* GetWallTransferTarget() const { return WallTransferTarget.Get(); }
+
+	/** Returns the normal of the wall that the character is running on. Only valid while wall running. */
+	FORCEINLINE const FVector& GetWallRunWallNormal() const { return WallRunWallNormal; }
+
 	/** Enables the character to enter a wall run. */
 	void WallRunStart();
 
@@ -72,20 +171,76 @@ public:
 	/** Delegate used to notify when the character has completed turning around a corner. Should only be subscribed to by the owning character. */
 	FOnCornerTurnEndSignature OnCornerTurnEnd;
 
+	/** Delegate used to notify when the character has started wall running. Should only be subscribed to by the owning character. */
+	FOnWallRunBeginSignature OnWallRunBegin;
+
+	/** Delegate used to notify when the character has stopped wall running. Should only be subscribed to by the owning character. */
+	FOnWallRunEndSignature OnWallRunEnd;
+
+	/** Delegate used to notify when the normal of the wall that the character is running on has noticeably changed. Should only be subscribed to by the owning character. */
+	FOnWallRunWallNormalChangedSignature OnWallRunWallNormalChanged;
+
+	/**
+	 * Record a wall run state transition at the character's location with the telemetry sink, if telemetry is enabled.
+	 *
+	 * @param Event:		The state transition.
+	 * @param Detail:		Event specific detail, see EWallRunTelemetryEvent.
+	 * @param Value0:		Event specific value, see EWallRunTelemetryEvent.
+	 * @param Value1:		Event specific value, see EWallRunTelemetryEvent.
+	 */
+	void RecordWallRunTelemetry(const EWallRunTelemetryEvent Event, const uint8 Detail, const float Value0 = 0.0f, const float Value1 = 0.0f) const;
+
+	/**
+	 * Record a wall run state transition at a given location with the telemetry sink, if telemetry is enabled.
+	 *
+	 * @param Event:		The state transition.
+	 * @param Location:		Location to attribute the event to.
+	 * @param Detail:		Event specific detail, see EWallRunTelemetryEvent.
+	 * @param Value0:		Event specific value, see EWallRunTelemetryEvent.
+	 * @param Value1:		Event specific value, see EWallRunTelemetryEvent.
+	 */
+	void RecordWallRunTelemetry(const EWallRunTelemetryEvent Event, const FVector3f& Location, const uint8 Detail, const float Value0 = 0.0f, const float Value1 = 0.0f) const;
+
 private:
 
 	/** FHitResult storing the hit info for wall run specific line traces. */
 	FHitResult WallRunHitResult{};
 
+	/** Normal of the wall that the character is running on. Kept separately from WallRunHitResult, which is reused by every probe. */
+	FVector WallRunWallNormal{};
+
+	/** The wall normal that was last notified through OnWallRunBegin or OnWallRunWallNormalChanged. */
+	FVector NotifiedWallRunWallNormal{};
+
+	/** Wall run state replicated to simulated proxies. */
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_WallRunRepSnapshot)
+	FWallRunRepSnapshot WallRunRepSnapshot;
+
 	/** World space FVector that stores the characters input while wall running and is set with the AddInputVector function. Used to detect if the character wants to turn around a corner. This will be zeroed out after every Tick. */
 	FVector WallRunControlInputVector{};
 
-	/** Actor pointer used to store the previous Actor that is not wall runnable. Primarily used for optimization. */
+	/** Most recent result of each wall run probe. Reused while the probe scheduler defers this character's requests. */
+	FWallRunProbeCache WallRunProbeCache[EWRP_MAX];
+
+	/** Incremented whenever the character's orientation relative to the wall changes abruptly, which invalidates all cached probe results. */
+	uint32 WallRunProbeGeneration = 0;
+
+	/** Surfaces that the character can't wall run on again until their cooldown ends. */
+	TArray<FWallRunSurfaceCooldown, TInlineAllocator<4>> WallRunSurfaceCooldowns;
+
+	/** The actor owning the surface that the character is running on. */
+	TWeakObjectPtr<const AActor> WallRunSurface{ nullptr };
+
+	/** The actor owning the surface that the character is transferring to after jumping off a wall. It can be wall run on regardless of its cooldown. */
+	TWeakObjectPtr<const AActor> WallTransferTarget{ nullptr };
+
+	/** Registry of the wallrunnable surfaces in the world. Used to find walls to transfer to without tracing for them. */
 	UPROPERTY(Transient)
-	TWeakObjectPtr<AActor> PrevNonWallrunnableActor{ nullptr };
+	UWallrunnableRegistrySubsystem* WallrunnableRegistry = nullptr;
 
-	/** Timer used to temporarily disable wall running after one has completed. */
-	FTimerHandle WallRunCooldownTimer;
+	/** Event bus that wall run state changes are published to. */
+	UPROPERTY(Transient)
+	UWallRunEventBusSubsystem* WallRunEventBus = nullptr;
 
 	/** The distance for line traces that search for walls to run on. */
 	double WallSearchTraceDistance = 0.0;
@@ -97,8 +252,12 @@ private:
 	/** The interpolation speed for rotating the character when wall running. */
 	UPROPERTY(EditAnywhere, Category = Movement, meta = (DisplayName = "Wall Run Rotation Interpolation Speed"))
 	float WallRunRotationInterpSpeed = 5.0f;
+
+	/** The angle in degrees that the wall normal has to turn by before OnWallRunWallNormalChanged is called. */
+	UPROPERTY(EditAnywhere, Category = Movement, meta = (DisplayName = "Wall Run Normal Change Notify Angle"))
+	float WallRunNormalChangeNotifyAngle = 2.0f;
 	
-	/** Time to temporarily disable wall running after one has completed. */
+	/** Time to temporarily disable wall running on a surface after a wall run on it has completed. Other surfaces can be wall run on immediately. */
 	UPROPERTY(EditAnywhere, Category = Movement, meta = (DisplayName = "Wall Run Cooldown Duration"))
 	float WallRunCooldownDuration = 0.7f;
 
@@ -106,6 +265,22 @@ private:
 	UPROPERTY(EditAnywhere, Category = Movement, meta = (DisplayName = "Wall Run Corner Turn Duration"))
 	float WallRunCornerTurnDuration = 0.3f;
 
+	/** The furthest a wall on the opposite side of the character can be to transfer to it by jumping. */
+	UPROPERTY(EditAnywhere, Category = Movement, meta = (DisplayName = "Wall Transfer Max Distance"))
+	float WallTransferMaxDistance = 600.0f;
+
+	/** Horizontal speed towards the opposite wall when transferring to it by jumping. */
+	UPROPERTY(EditAnywhere, Category = Movement, meta = (DisplayName = "Wall Transfer Speed"))
+	float WallTransferSpeed = 700.0f;
+
+	/** Speed away from the wall when jumping off a wall without a wall to transfer to. */
+	UPROPERTY(EditAnywhere, Category = Movement, meta = (DisplayName = "Wall Jump Off Speed"))
+	float WallJumpOffSpeed = 450.0f;
+
+	/** If true, wall run probes are batched by the UWallRunProbeSubsystem instead of being traced synchronously every frame. Predicted and replayed moves always trace synchronously. */
+	UPROPERTY(EditAnywhere, Category = Movement, meta = (DisplayName = "Use Wall Probe Scheduler"))
+	bool bUseWallProbeScheduler = true;
+
 	/** If true, the character can automatically wall run if they are close enough to a wall without requiring calls to WallRunStart or WallRunStop. */
 	UPROPERTY(EditAnywhere, Category = Movement, meta = (DisplayName = "Auto Wall Run"))
 	bool bAutoWallRun = true;
@@ -122,6 +297,15 @@ private:
 	/** Enum describing where is the wall relative to the character. Is the wall that the character's running on on the left or right side of the character? */
 	EWallRunSide WallRunSide{ EWRS_None };
 
+	/** The type of the corner that the character is turning around, or turned around last. */
+	ECornerType CornerTurnType{ ECT_Inner };
+
+	/** World time that the current wall run started at. Used for telemetry. Negative if no wall run was started on this machine, such as on simulated proxies. */
+	double WallRunStartTime = -1.0;
+
+	/** Distance travelled along walls during the current wall run. Used for telemetry. */
+	double WallRunDistance = 0.0;
+
 protected:
 
 	/** Called when the character's capsule component hit another object. */
@@ -131,9 +315,10 @@ protected:
 	/**
 	 * Check if the character has met the requirements to wall run.
 	 *
-	 * @return		True if the character can start wall running.
+	 * @param Surface:		The actor owning the surface that the character would wall run on.
+	 * @return				True if the character can start wall running.
 	 */
-	virtual bool CanWallRun() const;
+	virtual bool CanWallRun(const AActor* Surface) const;
 
 	/** Rotates the character to the initial orienation for wall runs to align with the wall. */
 	virtual void InitWallRun();
@@ -156,12 +341,38 @@ protected:
 
 	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
 
+	/** Moves simulated proxies along the replicated wall plane while wall running, without any physics queries. Network updates that change the movement mode are left to the base implementation. */
+	virtual void SimulateMovement(float DeltaTime) override;
+
+	/** Copies the current wall run state into WallRunRepSnapshot. Only called with authority. */
+	void UpdateWallRunRepSnapshot();
+
+	/** Applies the replicated wall run state on simulated proxies. */
+	UFUNCTION()
+	void OnRep_WallRunRepSnapshot();
+
+	/**
+	 * Check if the cooldown period for wall running on a surface is still in progress.
+	 *
+	 * @param Surface:		The actor owning the surface to check.
+	 * @return				True if the cooldown period for wall running on the surface is still in progress.
+	 */
+	bool IsWallRunCooldownActive(const AActor* Surface) const;
+
+	/** Starts the cooldown period for wall running on the surfaces of an actor. */
+	void StartWallRunCooldown(const AActor* Surface);
+
 	/**
-	 * Check if the cooldown period for wall running is still in progress.
+	 * Find a wall on the opposite side of the character to transfer to when jumping off the current wall. Only uses the geometry cached by the
+	 * UWallrunnableRegistrySubsystem, so it doesn't trace and gives the same result when a move is replayed or simulated on the server.
 	 *
-	 * @return		True if the cooldown period for wall running is still in progress.
+	 * @param OutTargetLocation:	[Out] The closest point on the wall to transfer to.
+	 * @return						The surface to transfer to, or null if there is no wallrunnable surface within WallTransferMaxDistance.
 	 */
-	bool IsWallRunCooldownActive() const;
+	const UPrimitiveComponent* FindWallTransferTarget(FVector& OutTargetLocation) const;
+
+	/** Removes surfaces whose cooldown has ended. */
+	void ExpireWallRunCooldowns();
 
 	/**
 	 * Turns the character around a previously detected corner while wall running.
@@ -170,7 +381,52 @@ protected:
 	 */
 	virtual void HandleWallRunCorner(const ECornerType CornerType);
 
+	/** Sets the normal of the wall that the character is running on, calling OnWallRunWallNormalChanged if it turned by more than WallRunNormalChangeNotifyAngle. */
+	void SetWallRunWallNormal(const FVector& WallNormal);
+
 	/** Called once the character has completed turning around a corner while wall running. */
 	UFUNCTION()
 	virtual void OnTurnedAroundCorner();
+
+	/**
+	 * Trace a wall run probe. When the probe scheduler can be used, the request is queued for the next batch and the most recent cached result is returned instead.
+	 * Falls back to a synchronous trace if there is no recent cached result for the current probe generation, which is charged to the scheduler's budget.
+	 *
+	 * @param Probe:		The probe to trace.
+	 * @param Start:		Start location of the probe.
+	 * @param End:			End location of the probe.
+	 * @param OutHit:		[Out] Hit info of the probe.
+	 * @return				True if the probe hit a wall.
+	 */
+	bool TraceWallRunProbe(const EWallRunProbe Probe, const FVector& Start, const FVector& End, FHitResult& OutHit);
+
+	/**
+	 * Check if the current move may use cached probe results from the scheduler.
+	 *
+	 * @return		False for moves that the owning client and the server both simulate, including replays, as each machine caches its own results on its own frames.
+	 */
+	bool CanUseWallProbeScheduler() const;
+
+	/**
+	 * Check if the character is approaching a corner based on the most recent probe results. Used to prioritise this character's probe requests.
+	 *
+	 * @return		True if the forward probe hit a wall or the side probe lost the wall.
+	 */
+	bool IsApproachingCorner() const;
+
+	/** Called when the wall run cooldown of a surface has expired. */
+	virtual void OnWallRunCooldownExpired();
+
+	/**
+	 * Publish a wall run event to the event bus, if anything is subscribed to it.
+	 *
+	 * @param Type:			The type of the event.
+	 * @param Direction:	Wall normal, or the corner turn direction for corner turn begin events.
+	 */
+	void PublishWallRunEvent(const EWallRunEventType Type, const FVector& Direction = FVector::ZeroVector) const;
+
+	/** Called by the UWallRunProbeSubsystem once a scheduled probe has been traced. */
+	void ReceiveWallRunProbeResult(const EWallRunProbe Probe, const uint32 Generation, const uint64 FrameNumber, const FHitResult& Hit);
+
+	friend class UWallRunProbeSubsystem;
 };
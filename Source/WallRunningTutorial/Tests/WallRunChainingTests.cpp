@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include <Components/CapsuleComponent.h>
+#include "Tests/WallRunTestWorld.h"
+#include "CustomCharacterMovementComponent.h"
+#include "WallRunEventBusSubsystem.h"
+#include "WallRunningTutorialCharacter.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWallRunChainedCorridorsTest, "WallRunningTutorial.Chaining.ChainedCorridors", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FWallRunChainedCorridorsTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumCorridors = 32;
+	static constexpr int32 NumSegmentsPerCorridor = 6;
+	static constexpr double CorridorSpacing = 1500.0;
+	static constexpr double CorridorHalfWidth = 250.0;
+	static constexpr double SegmentLength = 800.0;
+	static constexpr float StepSeconds = 1.0f / 60.0f;
+	static constexpr int32 NumFrames = 600;
+
+	/* Jump this long after a wall run has started, which is past the initial rotation onto the wall. */
+	static constexpr double JumpDelaySeconds = 0.4;
+
+	FWallRunTestWorld TestWorld;
+	UWorld* const World = TestWorld.GetWorld();
+
+	/* The corridor and side of every wall segment, to check that transfers cross the corridor. */
+	TMap<const AActor*, FIntPoint> SegmentCorridorSides;
+
+	/* Every corridor is a floor with wall segments on alternating sides, each starting halfway along the previous one, so runners have to transfer from wall to wall to get through it. */
+
+	for (int32 CorridorIndex = 0; CorridorIndex < NumCorridors; ++CorridorIndex)
+	{
+		const double Y = CorridorIndex * CorridorSpacing;
+		const double CorridorLength = (NumSegmentsPerCorridor + 1) * SegmentLength * 0.5;
+
+		TestWorld.SpawnWall(FVector(CorridorLength * 0.5, Y, -1000.0), FVector(CorridorLength * 0.5 + 1000.0, CorridorHalfWidth + 500.0, 10.0));
+
+		for (int32 SegmentIndex = 0; SegmentIndex < NumSegmentsPerCorridor; ++SegmentIndex)
+		{
+			const double SegmentSide = (SegmentIndex % 2 == 0) ? -1.0 : 1.0;
+			const double SegmentX = (SegmentIndex + 1) * SegmentLength * 0.5;
+
+			const AActor* const Segment = TestWorld.SpawnWall(FVector(SegmentX, Y + SegmentSide * CorridorHalfWidth, 0.0), FVector(SegmentLength * 0.5, 10.0, 800.0));
+			SegmentCorridorSides.Add(Segment, FIntPoint(CorridorIndex, SegmentIndex % 2));
+		}
+	}
+
+	/* Launch one runner per corridor at its first wall. */
+
+	TArray<AWallRunningTutorialCharacter*> Runners;
+
+	for (int32 CorridorIndex = 0; CorridorIndex < NumCorridors; ++CorridorIndex)
+	{
+		const FVector Location(100.0, CorridorIndex * CorridorSpacing - CorridorHalfWidth + 100.0, 0.0);
+
+		AWallRunningTutorialCharacter* const Runner = World->SpawnActor<AWallRunningTutorialCharacter>(AWallRunningTutorialCharacter::StaticClass(), Location, FRotator(0.0, -45.0, 0.0));
+
+		if (!TestNotNull(TEXT("Runner"), Runner)) return false;
+
+		UCustomCharacterMovementComponent* const Movement = Runner->GetCustomCharacterMovement();
+		Movement->bRunPhysicsWithNoController = true;
+		Movement->SetMovementMode(MOVE_Falling);
+		Movement->Velocity = FVector(400.0, -400.0, 200.0);
+
+		Runners.Add(Runner);
+	}
+
+	UWallRunEventBusSubsystem* const EventBus = World->GetSubsystem<UWallRunEventBusSubsystem>();
+	const TSharedRef<FWallRunEventSubscription, ESPMode::ThreadSafe> Subscription = EventBus->Subscribe(4096);
+
+	TMap<const UCustomCharacterMovementComponent*, double> WallRunStartTimes;
+
+	/* The wall that each runner jumped off, until the jump has been performed. */
+	TMap<const UCustomCharacterMovementComponent*, const AActor*> JumpedOffSurfaces;
+
+	/* The wall that each runner is transferring to, until its next wall run starts. */
+	TMap<const UCustomCharacterMovementComponent*, const AActor*> TransferTargets;
+
+	int32 NumWallRuns = 0;
+	int32 NumJumps = 0;
+	int32 NumTransfers = 0;
+	int32 NumTransfersAcrossCorridor = 0;
+	int32 NumChainedWallRuns = 0;
+	double TotalFrameSeconds = 0.0;
+	double MaxFrameSeconds = 0.0;
+
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		TestWorld.Tick(StepSeconds);
+		const double FrameSeconds = FPlatformTime::Seconds() - StartTime;
+
+		TotalFrameSeconds += FrameSeconds;
+		MaxFrameSeconds = FMath::Max(MaxFrameSeconds, FrameSeconds);
+
+		/* Jumps pressed after the previous tick were performed during this one. */
+
+		for (const TPair<const UCustomCharacterMovementComponent*, const AActor*>& JumpedOffSurface : JumpedOffSurfaces)
+		{
+			const AActor* const TransferTarget = JumpedOffSurface.Key->GetWallTransferTarget();
+
+			if (!TransferTarget) continue;
+
+			++NumTransfers;
+			TransferTargets.Add(JumpedOffSurface.Key, TransferTarget);
+
+			const FIntPoint* const FromCorridorSide = SegmentCorridorSides.Find(JumpedOffSurface.Value);
+			const FIntPoint* const ToCorridorSide = SegmentCorridorSides.Find(TransferTarget);
+
+			if (FromCorridorSide && ToCorridorSide && FromCorridorSide->X == ToCorridorSide->X && FromCorridorSide->Y != ToCorridorSide->Y)
+			{
+				++NumTransfersAcrossCorridor;
+			}
+		}
+
+		JumpedOffSurfaces.Reset();
+
+		FWallRunEvent Event{};
+
+		while (Subscription->Dequeue(Event))
+		{
+			if (Event.Type == EWallRunEventType::Entry)
+			{
+				WallRunStartTimes.Add(Event.Source, Event.WorldTimeSeconds);
+				++NumWallRuns;
+
+				/* A wall run is chained if it started on the wall that the runner transferred to. */
+				const AActor* TransferTarget = nullptr;
+
+				if (TransferTargets.RemoveAndCopyValue(Event.Source, TransferTarget) && TransferTarget == Event.Source->GetWallRunSurface())
+				{
+					++NumChainedWallRuns;
+				}
+			}
+			else if (Event.Type == EWallRunEventType::Exit)
+			{
+				WallRunStartTimes.Remove(Event.Source);
+			}
+		}
+
+		/* Jump off every wall once the runner has settled on it, which transfers to a segment across the corridor. */
+
+		for (AWallRunningTutorialCharacter* const Runner : Runners)
+		{
+			Runner->StopJumping();
+
+			const double* const WallRunStartTime = WallRunStartTimes.Find(Runner->GetCustomCharacterMovement());
+
+			if (WallRunStartTime && World->GetTimeSeconds() - *WallRunStartTime >= JumpDelaySeconds)
+			{
+				Runner->Jump();
+				WallRunStartTimes.Remove(Runner->GetCustomCharacterMovement());
+				JumpedOffSurfaces.Add(Runner->GetCustomCharacterMovement(), Runner->GetCustomCharacterMovement()->GetWallRunSurface());
+				++NumJumps;
+			}
+		}
+	}
+
+	EventBus->Unsubscribe(Subscription);
+
+	AddInfo(FString::Printf(TEXT("%d runners through %d-segment corridors: %d wall runs from %d wall jumps over %d frames, %d of them chained through %d transfers."),
+		NumCorridors, NumSegmentsPerCorridor, NumWallRuns, NumJumps, NumFrames, NumChainedWallRuns, NumTransfers));
+	AddInfo(FString::Printf(TEXT("World tick took %.3f ms on average and %.3f ms at most."), TotalFrameSeconds * 1000.0 / NumFrames, MaxFrameSeconds * 1000.0));
+
+	/* Every wall jump has a wall across the corridor to transfer to, and at least some transfers have to end in a new wall run on that wall. */
+	TestTrue(TEXT("Wall jumps transferred to another wall"), NumTransfers > 0);
+	TestEqual(TEXT("Transfers to the opposite wall of the same corridor"), NumTransfersAcrossCorridor, NumTransfers);
+	TestTrue(TEXT("Chained wall runs"), NumChainedWallRuns > 0);
+	TestTrue(TEXT("Wall runs beyond each runner's first"), NumWallRuns > NumCorridors);
+
+	return true;
+}
+
+#endif
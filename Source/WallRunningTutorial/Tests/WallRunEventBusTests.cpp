@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/WallRunTestWorld.h"
+#include "WallRunEventBusSubsystem.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWallRunEventBusPublishCostTest, "WallRunningTutorial.EventBus.PublishCost", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FWallRunEventBusPublishCostTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumSubscribers = 8;
+	static constexpr int32 NumBatches = 200;
+	static constexpr int32 NumEventsPerBatch = UWallRunEventBusSubsystem::DefaultSubscriptionCapacity / 2;
+
+	FWallRunTestWorld TestWorld;
+	UWallRunEventBusSubsystem* const EventBus = TestWorld.GetWorld()->GetSubsystem<UWallRunEventBusSubsystem>();
+
+	if (!TestNotNull(TEXT("Event bus"), EventBus)) return false;
+
+	TArray<TSharedRef<FWallRunEventSubscription, ESPMode::ThreadSafe>> Subscriptions;
+
+	for (int32 SubscriberIndex = 0; SubscriberIndex < NumSubscribers; ++SubscriberIndex)
+	{
+		Subscriptions.Add(EventBus->Subscribe());
+	}
+
+	FWallRunEvent Event{};
+	Event.Type = EWallRunEventType::Entry;
+
+	/* Only publishing is timed. Subscribers are drained between batches so that no event is dropped. */
+
+	double PublishSeconds = 0.0;
+	int32 NumReceived = 0;
+
+	for (int32 Batch = 0; Batch < NumBatches; ++Batch)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+
+		for (int32 EventIndex = 0; EventIndex < NumEventsPerBatch; ++EventIndex)
+		{
+			Event.WorldTimeSeconds = EventIndex;
+			EventBus->Publish(Event);
+		}
+
+		PublishSeconds += FPlatformTime::Seconds() - StartTime;
+
+		for (const TSharedRef<FWallRunEventSubscription, ESPMode::ThreadSafe>& Subscription : Subscriptions)
+		{
+			FWallRunEvent ReceivedEvent{};
+
+			while (Subscription->Dequeue(ReceivedEvent))
+			{
+				++NumReceived;
+			}
+
+			TestEqual(TEXT("Dropped events"), Subscription->ConsumeNumDropped(), 0u);
+		}
+	}
+
+	for (const TSharedRef<FWallRunEventSubscription, ESPMode::ThreadSafe>& Subscription : Subscriptions)
+	{
+		EventBus->Unsubscribe(Subscription);
+	}
+
+	const int32 NumPublished = NumBatches * NumEventsPerBatch;
+	TestEqual(TEXT("Received events"), NumReceived, NumPublished * NumSubscribers);
+
+	AddInfo(FString::Printf(TEXT("Publishing %d events to %d subscribers took %.1f ns per event."), NumPublished, NumSubscribers, PublishSeconds * 1000000000.0 / NumPublished));
+
+	return true;
+}
+
+#endif
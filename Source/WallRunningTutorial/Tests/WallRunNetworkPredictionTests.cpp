@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/WallRunTestWorld.h"
+#include "WallRunNetworkPrediction.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWallRunResimulationCostTest, "WallRunningTutorial.NetworkPrediction.ResimulationCost", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FWallRunResimulationCostTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumRunners = 64;
+	static constexpr int32 NumRollbackFrames = 10;
+	static constexpr int32 NumRollbacks = 100;
+	static constexpr int32 StepMS = 16;
+	static constexpr double CorridorSpacing = 1000.0;
+
+	/* Long enough for the corner runners to finish turning around the end wall. */
+	static constexpr int32 NumBehaviourFrames = 40;
+
+	FWallRunTestWorld TestWorld;
+
+	/* Give every runner its own corridor with a wall on the left, a floor and an end wall to turn at, so all kinds of queries are resimulated. */
+
+	for (int32 RunnerIndex = 0; RunnerIndex < NumRunners; ++RunnerIndex)
+	{
+		const double Y = RunnerIndex * CorridorSpacing;
+
+		TestWorld.SpawnWall(FVector(0.0, Y - 100.0, 0.0), FVector(2000.0, 10.0, 500.0));
+		TestWorld.SpawnWall(FVector(0.0, Y, -110.0), FVector(2000.0, 400.0, 10.0));
+		TestWorld.SpawnWall(FVector(150.0, Y, 0.0), FVector(10.0, 400.0, 500.0));
+	}
+
+	/* Let the physics scene pick up the new walls before querying it. */
+	TestWorld.Tick(StepMS / 1000.0f);
+
+	const FWallRunSimulation Simulation(TestWorld.GetWorld(), nullptr);
+	const FWallRunAuxState Aux{};
+
+	/*
+	 * Half of the runners start out wall running close to the end wall and steer around it. The other half start further back and jump at the side wall,
+	 * which they are still running along once the rollback window ends.
+	 */
+
+	TArray<FWallRunSyncState> Snapshot;
+	TArray<FWallRunInputCmd> Cmds;
+
+	auto IsCornerRunner = [](const int32 RunnerIndex) { return RunnerIndex % 2 == 0; };
+
+	for (int32 RunnerIndex = 0; RunnerIndex < NumRunners; ++RunnerIndex)
+	{
+		const double Y = RunnerIndex * CorridorSpacing;
+		const bool bWallRunning = IsCornerRunner(RunnerIndex);
+
+		FWallRunSyncState& Sync = Snapshot.AddDefaulted_GetRef();
+		Sync.Location = bWallRunning ? FVector(0.0, Y - 90.0 + Aux.CapsuleRadius, 0.0) : FVector(-400.0, Y - 80.0 + Aux.CapsuleRadius, 0.0);
+		Sync.Velocity = bWallRunning ? FVector(Aux.WallRunSpeed, 0.0, 0.0) : FVector(Aux.MaxWalkSpeed, -Aux.MaxWalkSpeed, 0.0);
+		Sync.WallNormal = bWallRunning ? FVector::RightVector : FVector::ZeroVector;
+		Sync.WallRunSide = bWallRunning ? EWRS_LeftSide : EWRS_None;
+		Sync.bWallRunning = bWallRunning;
+
+		FWallRunInputCmd& Cmd = Cmds.AddDefaulted_GetRef();
+		Cmd.MoveInput = FVector(1.0, bWallRunning ? 1.0 : -1.0, 0.0);
+	}
+
+	auto Simulate = [&Simulation, &Aux, &Cmds](TArray<FWallRunSyncState>& States, const int32 NumFrames = NumRollbackFrames)
+	{
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (int32 RunnerIndex = 0; RunnerIndex < NumRunners; ++RunnerIndex)
+			{
+				Simulation.SimulateFrame(StepMS, Cmds[RunnerIndex], Aux, States[RunnerIndex]);
+			}
+		}
+	};
+
+	TArray<FWallRunSyncState> Expected = Snapshot;
+	Simulate(Expected);
+
+	/* The rollback window has to cover actual wall runs and corner turns, or the cost below doesn't measure them. */
+
+	for (int32 RunnerIndex = 0; RunnerIndex < NumRunners; ++RunnerIndex)
+	{
+		const FWallRunSyncState& Sync = Expected[RunnerIndex];
+
+		if (IsCornerRunner(RunnerIndex))
+		{
+			TestTrue(FString::Printf(TEXT("Corner runner %d is turning around the end wall"), RunnerIndex),
+				Sync.bWallRunning && Sync.CornerTurnFramesRemaining > 0 && Sync.WallNormal.Equals(FVector::BackwardVector, 0.01));
+		}
+		else
+		{
+			TestTrue(FString::Printf(TEXT("Side runner %d is wall running along the side wall"), RunnerIndex),
+				Sync.bWallRunning && Sync.WallRunSide == EWRS_LeftSide && Sync.WallNormal.Equals(FVector::RightVector, 0.01));
+		}
+	}
+
+	TArray<FWallRunSyncState> Finished = Snapshot;
+	Simulate(Finished, NumBehaviourFrames);
+
+	for (int32 RunnerIndex = 0; RunnerIndex < NumRunners; ++RunnerIndex)
+	{
+		const FWallRunSyncState& Sync = Finished[RunnerIndex];
+
+		if (IsCornerRunner(RunnerIndex))
+		{
+			TestTrue(FString::Printf(TEXT("Corner runner %d runs along the end wall after the turn"), RunnerIndex),
+				Sync.bWallRunning && Sync.CornerTurnFramesRemaining == 0 && Sync.WallNormal.Equals(FVector::BackwardVector, 0.01)
+				&& FVector::DotProduct(Sync.Rotation.GetForwardVector(), FVector::RightVector) > 0.99);
+		}
+		else
+		{
+			TestTrue(FString::Printf(TEXT("Side runner %d still wall runs along the side wall"), RunnerIndex),
+				Sync.bWallRunning && Sync.WallNormal.Equals(FVector::RightVector, 0.01));
+		}
+	}
+
+	/* Roll back to the snapshot and resimulate the same frames, which must reproduce the original result exactly. */
+
+	TArray<FWallRunSyncState> Resimulated;
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 Rollback = 0; Rollback < NumRollbacks; ++Rollback)
+	{
+		Resimulated = Snapshot;
+		Simulate(Resimulated);
+	}
+
+	const double RollbackMS = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumRollbacks;
+
+	for (int32 RunnerIndex = 0; RunnerIndex < NumRunners; ++RunnerIndex)
+	{
+		const FWallRunSyncState& A = Expected[RunnerIndex];
+		const FWallRunSyncState& B = Resimulated[RunnerIndex];
+
+		const bool bIdentical = A.Location == B.Location && A.Velocity == B.Velocity && A.Rotation == B.Rotation && A.WallNormal == B.WallNormal
+			&& A.bWallRunning == B.bWallRunning && A.WallRunSide == B.WallRunSide
+			&& A.CooldownFramesRemaining == B.CooldownFramesRemaining && A.CornerTurnFramesRemaining == B.CornerTurnFramesRemaining;
+
+		TestTrue(FString::Printf(TEXT("Runner %d resimulates identically"), RunnerIndex), bIdentical);
+	}
+
+	AddInfo(FString::Printf(TEXT("Resimulating %d frames for %d runners took %.3f ms (%.2f us per runner frame)."),
+		NumRollbackFrames, NumRunners, RollbackMS, RollbackMS * 1000.0 / (NumRollbackFrames * NumRunners)));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include <HAL/FileManager.h>
+#include <Misc/Paths.h>
+#include "Tests/WallRunTestWorld.h"
+#include "CustomCharacterMovementComponent.h"
+#include "WallRunningTutorialCharacter.h"
+#include "WallRunTelemetry.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWallRunTelemetryRecordCostTest, "WallRunningTutorial.Telemetry.RecordCost", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FWallRunTelemetryRecordCostTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumBatches = 50;
+	static constexpr int32 NumRecordsPerBatch = FWallRunTelemetry::ThreadBufferCapacity / 2;
+	static constexpr double TargetRecordUS = 1.0;
+
+	FWallRunTestWorld TestWorld;
+
+	AWallRunningTutorialCharacter* const Character = TestWorld.GetWorld()->SpawnActor<AWallRunningTutorialCharacter>(AWallRunningTutorialCharacter::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+
+	if (!TestNotNull(TEXT("Character"), Character)) return false;
+
+	const UCustomCharacterMovementComponent* const Movement = Character->GetCustomCharacterMovement();
+
+	/* Reuse a running sink instead of restarting it underneath the game. */
+	const bool bStartedSink = !FWallRunTelemetry::IsEnabled();
+	const FString Directory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("WallRunTelemetry"));
+
+	if (bStartedSink)
+	{
+		FWallRunTelemetry::Start(Directory, 16 * 1024 * 1024, 2);
+	}
+
+	/* The first record from a thread allocates its buffer, so keep it out of the measurement. */
+	Movement->RecordWallRunTelemetry(EWallRunTelemetryEvent::WallRunBegin, 0);
+	FWallRunTelemetry::Flush();
+
+	const uint64 NumDroppedBefore = FWallRunTelemetry::GetNumDroppedRecords();
+
+	/* Only recording is timed. The buffers are drained between batches so that no record is dropped. */
+
+	double RecordSeconds = 0.0;
+
+	for (int32 Batch = 0; Batch < NumBatches; ++Batch)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+
+		for (int32 RecordIndex = 0; RecordIndex < NumRecordsPerBatch; ++RecordIndex)
+		{
+			Movement->RecordWallRunTelemetry(EWallRunTelemetryEvent::WallRunEnd, 0, static_cast<float>(RecordIndex));
+		}
+
+		RecordSeconds += FPlatformTime::Seconds() - StartTime;
+
+		FWallRunTelemetry::Flush();
+	}
+
+	TestEqual(TEXT("Dropped records"), FWallRunTelemetry::GetNumDroppedRecords() - NumDroppedBefore, static_cast<uint64>(0));
+
+	if (bStartedSink)
+	{
+		FWallRunTelemetry::Stop();
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	}
+
+	const int32 NumRecords = NumBatches * NumRecordsPerBatch;
+	const double RecordUS = RecordSeconds * 1000000.0 / NumRecords;
+
+	AddInfo(FString::Printf(TEXT("Recording %d telemetry events took %.3f us per event."), NumRecords, RecordUS));
+
+	if (RecordUS > TargetRecordUS)
+	{
+		AddWarning(FString::Printf(TEXT("Recording a telemetry event took %.3f us, above the %.1f us target."), RecordUS, TargetRecordUS));
+	}
+
+	return true;
+}
+
+#endif
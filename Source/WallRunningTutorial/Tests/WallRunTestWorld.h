@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include <Components/StaticMeshComponent.h>
+#include <Engine/Engine.h>
+#include <Engine/StaticMesh.h>
+#include <Engine/World.h>
+#include <GameFramework/WorldSettings.h>
+#include "WallrunnableStaticMeshActor.h"
+
+/**
+ * FWallRunTestWorld owns a transient game world that has begun play, for automation tests that need wall run subsystems and actors.
+ * The world is destroyed along with this object.
+ */
+class FWallRunTestWorld
+{
+public:
+
+	FWallRunTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+		GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+
+		/* Without a game mode, actors are only told to begin play by the world settings. */
+		if (!World->HasBegunPlay())
+		{
+			World->GetWorldSettings()->NotifyBeginPlay();
+		}
+	}
+
+	~FWallRunTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	FWallRunTestWorld(const FWallRunTestWorld&) = delete;
+	FWallRunTestWorld& operator=(const FWallRunTestWorld&) = delete;
+
+	UWorld* GetWorld() const { return World; }
+
+	/**
+	 * Spawns a box shaped wallrunnable wall.
+	 *
+	 * @param Location		Center of the wall.
+	 * @param Extent		Half size of the wall along each axis.
+	 * @param Mobility		Mobility of the wall's mesh.
+	 * @return				The spawned wall.
+	 */
+	AWallrunnableStaticMeshActor* SpawnWall(const FVector& Location, const FVector& Extent, const EComponentMobility::Type Mobility = EComponentMobility::Static) const
+	{
+		/* The engine cube is 100 units wide. */
+		const FTransform Transform(FQuat::Identity, Location, Extent / 50.0);
+
+		AWallrunnableStaticMeshActor* const Wall = World->SpawnActorDeferred<AWallrunnableStaticMeshActor>(AWallrunnableStaticMeshActor::StaticClass(), Transform);
+		UStaticMeshComponent* const MeshComponent = Wall->GetStaticMeshComponent();
+
+		/* Static meshes can only be changed while the component is movable. */
+		MeshComponent->SetMobility(EComponentMobility::Movable);
+		MeshComponent->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+		MeshComponent->SetMobility(Mobility);
+
+		Wall->FinishSpawning(Transform);
+		return Wall;
+	}
+
+	/** Ticks the world once. */
+	void Tick(const float DeltaSeconds) const
+	{
+		World->Tick(LEVELTICK_All, DeltaSeconds);
+	}
+
+private:
+
+	UWorld* World = nullptr;
+};
+
+#endif
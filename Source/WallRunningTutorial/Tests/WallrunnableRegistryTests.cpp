@@ -0,0 +1,198 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include <Components/BoxComponent.h>
+#include "Tests/WallRunTestWorld.h"
+#include "Tests/WallrunnableTestActor.h"
+#include "WallrunnableRegistrySubsystem.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWallrunnableRegistryMovingWallsTest, "WallRunningTutorial.Registry.MovingWalls", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FWallrunnableRegistryMovingWallsTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumWalls = 1000;
+	static constexpr int32 NumFrames = 120;
+	static constexpr int32 NumQueriesPerFrame = 64;
+	static constexpr int32 NumRespawnsPerFrame = 8;
+	static constexpr double FieldSize = 20000.0;
+	static constexpr double MaxWallSpeed = 1200.0;
+	static constexpr float QueryRadius = 600.0f;
+	static constexpr float StepSeconds = 1.0f / 60.0f;
+
+	FWallRunTestWorld TestWorld;
+	UWallrunnableRegistrySubsystem* const Registry = TestWorld.GetWorld()->GetSubsystem<UWallrunnableRegistrySubsystem>();
+
+	if (!TestNotNull(TEXT("Registry"), Registry)) return false;
+
+	/* Fixed seed, so every run moves the walls the same way. */
+	FRandomStream Random(35);
+
+	auto RandomLocation = [&Random]()
+	{
+		return FVector(Random.FRandRange(0.0, FieldSize), Random.FRandRange(0.0, FieldSize), Random.FRandRange(0.0, 2000.0));
+	};
+
+	auto SpawnMovingWall = [&TestWorld, &Random, &RandomLocation]()
+	{
+		const FVector Extent(Random.FRandRange(50.0, 800.0), 10.0, Random.FRandRange(100.0, 600.0));
+		return TestWorld.SpawnWall(RandomLocation(), Extent, EComponentMobility::Movable);
+	};
+
+	TArray<AWallrunnableStaticMeshActor*> Walls;
+	TArray<FVector> Velocities;
+
+	for (int32 WallIndex = 0; WallIndex < NumWalls; ++WallIndex)
+	{
+		Walls.Add(SpawnMovingWall());
+		Velocities.Add(Random.GetUnitVector() * Random.FRandRange(0.0, MaxWallSpeed));
+	}
+
+	/* Every wall is registered once, however many times it was picked up while spawning. */
+	TestEqual(TEXT("Registered surfaces"), Registry->GetNumSurfaces(), NumWalls);
+
+	TArray<UPrimitiveComponent*> Found;
+	TArray<UPrimitiveComponent*> Expected;
+	int32 NumMismatches = 0;
+	int64 NumFound = 0;
+	double MoveSeconds = 0.0;
+	double RespawnSeconds = 0.0;
+	double QuerySeconds = 0.0;
+
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		/* Moving the walls is what updates the registry, through the proxies' transform updates. */
+		const double MoveStartSeconds = FPlatformTime::Seconds();
+
+		for (int32 WallIndex = 0; WallIndex < Walls.Num(); ++WallIndex)
+		{
+			Walls[WallIndex]->SetActorLocation(Walls[WallIndex]->GetActorLocation() + Velocities[WallIndex] * StepSeconds);
+		}
+
+		MoveSeconds += FPlatformTime::Seconds() - MoveStartSeconds;
+
+		/* Replace a few walls each frame, as spawned platforms and debris come and go. */
+		const double RespawnStartSeconds = FPlatformTime::Seconds();
+
+		for (int32 RespawnIndex = 0; RespawnIndex < NumRespawnsPerFrame; ++RespawnIndex)
+		{
+			const int32 WallIndex = Random.RandHelper(Walls.Num());
+
+			Walls[WallIndex]->Destroy();
+			Walls[WallIndex] = SpawnMovingWall();
+		}
+
+		RespawnSeconds += FPlatformTime::Seconds() - RespawnStartSeconds;
+
+		for (int32 QueryIndex = 0; QueryIndex < NumQueriesPerFrame; ++QueryIndex)
+		{
+			const FVector Location = RandomLocation();
+
+			Found.Reset();
+
+			const double QueryStartSeconds = FPlatformTime::Seconds();
+			Registry->QueryNearby(Location, QueryRadius, Found);
+			QuerySeconds += FPlatformTime::Seconds() - QueryStartSeconds;
+
+			/* Check against every wall, so surfaces that moved between cells or respawned can't be missed. */
+			Expected.Reset();
+
+			for (const AWallrunnableStaticMeshActor* const Wall : Walls)
+			{
+				UBoxComponent* const Proxy = Wall->GetWallRunProxy();
+
+				if (FMath::SphereAABBIntersection(Location, FMath::Square(QueryRadius), Proxy->Bounds.GetBox()))
+				{
+					Expected.Add(Proxy);
+				}
+			}
+
+			Found.Sort();
+			Expected.Sort();
+
+			if (Found != Expected)
+			{
+				++NumMismatches;
+			}
+
+			NumFound += Found.Num();
+		}
+	}
+
+	TestEqual(TEXT("Queries that differ from a brute force search"), NumMismatches, 0);
+	TestEqual(TEXT("Registered surfaces after respawning"), Registry->GetNumSurfaces(), NumWalls);
+
+	const double NumQueries = static_cast<double>(NumFrames) * NumQueriesPerFrame;
+
+	AddInfo(FString::Printf(TEXT("%d moving walls over %d frames: %.3f ms moving per frame, %.3f ms respawning %d walls per frame."),
+		NumWalls, NumFrames, MoveSeconds * 1000.0 / NumFrames, RespawnSeconds * 1000.0 / NumFrames, NumRespawnsPerFrame));
+	AddInfo(FString::Printf(TEXT("%.0f queries: %.2f us each, %.1f surfaces found on average."),
+		NumQueries, QuerySeconds * 1000000.0 / NumQueries, NumFound / NumQueries));
+
+	/* Soft limit, as timings depend on the machine running the test. */
+	if (QuerySeconds * 1000000.0 / NumQueries > 50.0)
+	{
+		AddWarning(TEXT("Registry queries took over 50 us each."));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWallrunnableRegistryGenericActorsTest, "WallRunningTutorial.Registry.GenericActors", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FWallrunnableRegistryGenericActorsTest::RunTest(const FString& Parameters)
+{
+	static constexpr float QueryRadius = 100.0f;
+
+	FWallRunTestWorld TestWorld;
+	UWorld* const World = TestWorld.GetWorld();
+	UWallrunnableRegistrySubsystem* const Registry = World->GetSubsystem<UWallrunnableRegistrySubsystem>();
+
+	if (!TestNotNull(TEXT("Registry"), Registry)) return false;
+
+	auto FindsSurface = [Registry](const FVector& Location, const UPrimitiveComponent* Surface)
+	{
+		TArray<UPrimitiveComponent*> Found;
+		Registry->QueryNearby(Location, QueryRadius, Found);
+		return Found.Contains(Surface);
+	};
+
+	/* The test actor implements IWallrunnableInterface without registering itself, so only the registry's spawn handler can pick it up. */
+	const FVector SpawnLocation(1000.0, 0.0, 0.0);
+
+	AWallrunnableTestActor* const Actor = World->SpawnActor<AWallrunnableTestActor>(AWallrunnableTestActor::StaticClass(), SpawnLocation, FRotator::ZeroRotator);
+
+	if (!TestNotNull(TEXT("Wallrunnable actor"), Actor)) return false;
+
+	UBoxComponent* const Box = Actor->GetBox();
+
+	TestTrue(TEXT("Registered when spawned"), Registry->IsRegistered(Box));
+	TestTrue(TEXT("Found where it spawned"), FindsSurface(SpawnLocation, Box));
+
+	/* Moving the actor has to move its surface in the registry. */
+	const FVector MovedLocation(6000.0, 3000.0, 0.0);
+	Actor->SetActorLocation(MovedLocation);
+
+	TestFalse(TEXT("Found where it spawned after moving"), FindsSurface(SpawnLocation, Box));
+	TestTrue(TEXT("Found where it moved to"), FindsSurface(MovedLocation, Box));
+
+	/* A level being streamed in registers the wallrunnable actors in it. */
+	Registry->UnregisterActor(Actor);
+	TestFalse(TEXT("Registered after unregistering"), Registry->IsRegistered(Box));
+
+	FWorldDelegates::LevelAddedToWorld.Broadcast(World->PersistentLevel, World);
+	TestTrue(TEXT("Registered when its level is added"), Registry->IsRegistered(Box));
+
+	/* Ending play unregisters the actor. */
+	Actor->Destroy();
+
+	TestFalse(TEXT("Registered after being destroyed"), Registry->IsRegistered(Box));
+	TestEqual(TEXT("Registered surfaces after being destroyed"), Registry->GetNumSurfaces(), 0);
+
+	return true;
+}
+
+#endif
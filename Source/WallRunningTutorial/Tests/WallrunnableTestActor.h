@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <Components/BoxComponent.h>
+#include "GameFramework/Actor.h"
+#include "WallrunnableInterface.h"
+#include "WallRunCollisionChannels.h"
+#include "WallrunnableTestActor.generated.h"
+
+/**
+ * AWallrunnableTestActor is a bare wallrunnable actor with a single box that only blocks the wall run trace channel.
+ * Unlike AWallrunnableStaticMeshActor, it never registers itself, so automation tests can check that the registry picks up any wallrunnable actor.
+ */
+UCLASS(NotBlueprintable, NotPlaceable, Transient, HideDropdown)
+class WALLRUNNINGTUTORIAL_API AWallrunnableTestActor : public AActor, public IWallrunnableInterface
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = WallRun)
+	UBoxComponent* Box;
+
+public:
+
+	AWallrunnableTestActor()
+	{
+		Box = CreateDefaultSubobject<UBoxComponent>(TEXT("Box"));
+		Box->SetMobility(EComponentMobility::Movable);
+		Box->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		Box->SetCollisionResponseToAllChannels(ECR_Ignore);
+		Box->SetCollisionResponseToChannel(ECC_WallRun, ECR_Block);
+		RootComponent = Box;
+	}
+
+	FORCEINLINE UBoxComponent* GetBox() const { return Box; }
+};
@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WallRunAssetSet.h"
+
+const FName UWallRunAssetSet::GameBundle{ TEXT("Game") };
+const FName UWallRunAssetSet::ClientBundle{ TEXT("Client") };
+const FPrimaryAssetType UWallRunAssetSet::PrimaryAssetType{ TEXT("WallRunAssetSet") };
+
+FPrimaryAssetId UWallRunAssetSet::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+void UWallRunAssetSet::GetBundleAssets(const FName Bundle, TArray<FSoftObjectPath>& OutAssets) const
+{
+	/* Mirrors the AssetBundles metadata of the properties, which isn't available in cooked builds. */
+	auto AddAsset = [&OutAssets](const FSoftObjectPath& AssetPath)
+	{
+		if (!AssetPath.IsNull())
+		{
+			OutAssets.AddUnique(AssetPath);
+		}
+	};
+
+	if (Bundle == GameBundle)
+	{
+		AddAsset(PawnClass.ToSoftObjectPath());
+
+		for (const TSoftObjectPtr<UPhysicalMaterial>& SurfaceMaterial : SurfaceMaterials)
+		{
+			AddAsset(SurfaceMaterial.ToSoftObjectPath());
+		}
+	}
+	else if (Bundle == ClientBundle)
+	{
+		for (const TSoftObjectPtr<UObject>& InputAsset : InputAssets)
+		{
+			AddAsset(InputAsset.ToSoftObjectPath());
+		}
+
+		for (const TSoftObjectPtr<UAnimationAsset>& Animation : Animations)
+		{
+			AddAsset(Animation.ToSoftObjectPath());
+		}
+	}
+}
@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "WallRunAssetSet.generated.h"
+
+class UAnimationAsset;
+class UPhysicalMaterial;
+
+/**
+ * UWallRunAssetSet is a primary data asset listing everything needed to wall run, so the Asset Manager can stream it in asynchronously while a map loads.
+ * Assets in the "Game" bundle are needed on every machine, while assets in the "Client" bundle are only loaded on machines that render and take input.
+ * The class default object is the default asset set and is filled in from config, so the game streams its assets in without an authored asset.
+ */
+UCLASS(BlueprintType, config = Game)
+class WALLRUNNINGTUTORIAL_API UWallRunAssetSet : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Name of the bundle holding assets needed on every machine. */
+	static const FName GameBundle;
+
+	/** Name of the bundle holding assets only needed on machines that render and take input. */
+	static const FName ClientBundle;
+
+	/** Primary asset type of every wall run asset set. */
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	/**
+	 * Collect the assets of a bundle. Used for the default asset set, as the Asset Manager only knows the bundles of authored asset sets.
+	 *
+	 * @param Bundle:			Name of the bundle.
+	 * @param OutAssets:		[Out] Paths of the bundle's assets.
+	 */
+	void GetBundleAssets(const FName Bundle, TArray<FSoftObjectPath>& OutAssets) const;
+
+	/** Pawn class spawned for players by default. */
+	UPROPERTY(EditDefaultsOnly, Config, Category = Pawn, meta = (AssetBundles = "Game"))
+	TSoftClassPtr<APawn> PawnClass;
+
+	/** Input mapping contexts and input actions used by the pawn. */
+	UPROPERTY(EditDefaultsOnly, Config, Category = Input, meta = (AssetBundles = "Client", AllowedClasses = "/Script/EnhancedInput.InputMappingContext,/Script/EnhancedInput.InputAction"))
+	TArray<TSoftObjectPtr<UObject>> InputAssets;
+
+	/** Animations played while wall running and turning around corners. */
+	UPROPERTY(EditDefaultsOnly, Config, Category = Animation, meta = (AssetBundles = "Client"))
+	TArray<TSoftObjectPtr<UAnimationAsset>> Animations;
+
+	/** Physical materials of the surfaces that can be wall run on, along with any per-surface data they reference. */
+	UPROPERTY(EditDefaultsOnly, Config, Category = Surfaces, meta = (AssetBundles = "Game"))
+	TArray<TSoftObjectPtr<UPhysicalMaterial>> SurfaceMaterials;
+};
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WallRunAssetSubsystem.h"
+#include <Engine/AssetManager.h>
+#include "WallRunAssetSet.h"
+
+void UWallRunAssetSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TArray<FName> Bundles{ UWallRunAssetSet::GameBundle };
+
+	if (!IsRunningDedicatedServer())
+	{
+		Bundles.Add(UWallRunAssetSet::ClientBundle);
+	}
+
+	UAssetManager& AssetManager = UAssetManager::Get();
+	const FStreamableDelegate LoadedDelegate = FStreamableDelegate::CreateUObject(this, &UWallRunAssetSubsystem::OnAssetsLoaded);
+
+	LoadStartTime = FPlatformTime::Seconds();
+
+	if (WallRunAssetSetId.IsValid())
+	{
+		/* Fall back to the default asset set instead of requesting a load that can only fail. */
+		if (AssetManager.GetPrimaryAssetPath(WallRunAssetSetId).IsValid())
+		{
+			bUseDefaultAssetSet = false;
+			LoadHandle = AssetManager.LoadPrimaryAsset(WallRunAssetSetId, Bundles, LoadedDelegate);
+		}
+		else
+		{
+			UE_LOG(LogAssetManager, Warning, TEXT("%s: Wall run asset set '%s' doesn't exist. Streaming in the default asset set instead."), *GetNameSafe(this), *WallRunAssetSetId.ToString());
+		}
+	}
+
+	if (bUseDefaultAssetSet)
+	{
+		TArray<FSoftObjectPath> AssetsToLoad;
+
+		for (const FName Bundle : Bundles)
+		{
+			GetDefault<UWallRunAssetSet>()->GetBundleAssets(Bundle, AssetsToLoad);
+		}
+
+		LoadHandle = AssetManager.GetStreamableManager().RequestAsyncLoad(AssetsToLoad, LoadedDelegate);
+	}
+
+	/* Nothing had to be loaded, in which case the delegate isn't called. */
+	if (!LoadHandle.IsValid() && LoadSeconds < 0.0)
+	{
+		OnAssetsLoaded();
+	}
+}
+
+void UWallRunAssetSubsystem::Deinitialize()
+{
+	if (LoadHandle.IsValid())
+	{
+		LoadHandle->ReleaseHandle();
+		LoadHandle.Reset();
+	}
+
+	AssetsLoadedDelegate.Clear();
+
+	Super::Deinitialize();
+}
+
+const UWallRunAssetSet* UWallRunAssetSubsystem::GetAssetSet() const
+{
+	if (bUseDefaultAssetSet) return GetDefault<UWallRunAssetSet>();
+
+	return UAssetManager::Get().GetPrimaryAssetObject<UWallRunAssetSet>(WallRunAssetSetId);
+}
+
+void UWallRunAssetSubsystem::CallOrRegister_OnAssetsLoaded(FSimpleMulticastDelegate::FDelegate&& Delegate)
+{
+	if (LoadSeconds >= 0.0)
+	{
+		Delegate.Execute();
+	}
+	else
+	{
+		AssetsLoadedDelegate.Add(MoveTemp(Delegate));
+	}
+}
+
+void UWallRunAssetSubsystem::OnAssetsLoaded()
+{
+	LoadSeconds = FPlatformTime::Seconds() - LoadStartTime;
+
+	UE_LOG(LogAssetManager, Log, TEXT("%s: Streamed in the wall run assets in %.1f ms."), *GetNameSafe(this), LoadSeconds * 1000.0);
+
+	AssetsLoadedDelegate.Broadcast();
+	AssetsLoadedDelegate.Clear();
+}
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "WallRunAssetSubsystem.generated.h"
+
+class UWallRunAssetSet;
+struct FStreamableHandle;
+
+/**
+ * UWallRunAssetSubsystem streams in the wall run asset set as soon as the game instance starts, on servers and clients alike, so the first map load
+ * overlaps with it. The "Game" bundle, including the pawn class, is loaded everywhere and the "Client" bundle everywhere but dedicated servers. The assets
+ * stay loaded for the lifetime of the game instance, so later map loads and server travel find them already resident.
+ */
+UCLASS(config = Game)
+class WALLRUNNINGTUTORIAL_API UWallRunAssetSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/** Returns the configured wall run asset set, or the default asset set if none is configured or it couldn't be resolved. Null while a configured asset set is still loading. */
+	const UWallRunAssetSet* GetAssetSet() const;
+
+	/** Returns the handle of the asset set's outstanding or completed load, or null if nothing had to be loaded. */
+	FORCEINLINE TSharedPtr<FStreamableHandle> GetLoadHandle() const { return LoadHandle; }
+
+	/** Returns the time in seconds that the assets took to stream in, or a negative value while they are still streaming in. */
+	FORCEINLINE double GetLoadSeconds() const { return LoadSeconds; }
+
+	/**
+	 * Call a delegate once the wall run assets have streamed in, or right away if they already have.
+	 *
+	 * @param Delegate:		The delegate to call.
+	 */
+	void CallOrRegister_OnAssetsLoaded(FSimpleMulticastDelegate::FDelegate&& Delegate);
+
+protected:
+
+	/** Called once the asset set and its bundles have streamed in. */
+	virtual void OnAssetsLoaded();
+
+private:
+
+	/** Primary asset ID of an authored UWallRunAssetSet to stream in. Leave unset to stream the default asset set from config. */
+	UPROPERTY(Config)
+	FPrimaryAssetId WallRunAssetSetId;
+
+	/** Handle keeping the asset set and its bundles loaded. */
+	TSharedPtr<FStreamableHandle> LoadHandle;
+
+	/** True if the default asset set is used instead of WallRunAssetSetId. */
+	bool bUseDefaultAssetSet = true;
+
+	/** Time that streaming started at. */
+	double LoadStartTime = 0.0;
+
+	/** Time in seconds that the assets took to stream in. Negative while they are still streaming in. */
+	double LoadSeconds = -1.0;
+
+	/** Called once the assets have streamed in. */
+	FSimpleMulticastDelegate AssetsLoadedDelegate;
+};
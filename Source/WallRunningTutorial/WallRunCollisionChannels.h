@@ -0,0 +1,9 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/**
+ * Trace channel used exclusively by wall running queries. Configured in DefaultEngine.ini with a default response of ignore,
+ * so only the simple proxy shapes of wallrunnable actors (or meshes that explicitly opt in) respond to it.
+ */
+#define ECC_WallRun ECC_GameTraceChannel1
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WallRunEventBusSubsystem.h"
+
+FWallRunEventSubscription::FWallRunEventSubscription(const uint32 Capacity)
+	/* TCircularQueue always leaves one slot free, so it needs one more slot than the number of events it has to hold. */
+	: Queue(FMath::RoundUpToPowerOfTwo(FMath::Max(Capacity, 1u) + 1))
+{
+}
+
+void FWallRunEventSubscription::Enqueue(const FWallRunEvent& Event)
+{
+	if (!Queue.Enqueue(Event))
+	{
+		NumDropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+TSharedRef<FWallRunEventSubscription, ESPMode::ThreadSafe> UWallRunEventBusSubsystem::Subscribe(const uint32 Capacity)
+{
+	check(IsInGameThread());
+
+	return Subscriptions.Add_GetRef(MakeShared<FWallRunEventSubscription, ESPMode::ThreadSafe>(Capacity));
+}
+
+void UWallRunEventBusSubsystem::Unsubscribe(const TSharedRef<FWallRunEventSubscription, ESPMode::ThreadSafe>& Subscription)
+{
+	check(IsInGameThread());
+
+	Subscriptions.RemoveSingleSwap(Subscription);
+}
+
+void UWallRunEventBusSubsystem::Publish(const FWallRunEvent& Event)
+{
+	checkSlow(IsInGameThread());
+
+	for (const TSharedRef<FWallRunEventSubscription, ESPMode::ThreadSafe>& Subscription : Subscriptions)
+	{
+		Subscription->Enqueue(Event);
+	}
+}
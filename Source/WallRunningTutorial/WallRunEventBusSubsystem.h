@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include "Containers/CircularQueue.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CustomCharacterMovementComponent.h"
+#include "WallRunEventBusSubsystem.generated.h"
+
+/** Types of wall run events published on the event bus. */
+enum class EWallRunEventType : uint8
+{
+	/** The character started wall running. */
+	Entry,
+
+	/** The character stopped wall running. */
+	Exit,
+
+	/** The character started wall running with the wall on the other side than its previous wall run. */
+	SideChange,
+
+	/** The character is beginning to turn around a corner. Direction is the corner turn direction. */
+	CornerTurnBegin,
+
+	/** The character completed turning around a corner. */
+	CornerTurnEnd,
+
+	/** The character's wall run cooldown expired. */
+	CooldownExpired,
+};
+
+/** A wall run event record. Plain data, so it can be consumed on any thread. */
+struct FWallRunEvent
+{
+	/** The movement component that published the event. Only dereference on the game thread. */
+	const UCustomCharacterMovementComponent* Source = nullptr;
+
+	/** World time that the event was published at. */
+	double WorldTimeSeconds = 0.0;
+
+	/** World location of the character when the event was published. */
+	FVector Location{};
+
+	/** Wall normal, or the corner turn direction for EWallRunEventType::CornerTurnBegin. */
+	FVector Direction{};
+
+	EWallRunEventType Type{};
+
+	/** Which side of the character the wall is on. */
+	EWallRunSide WallRunSide{ EWRS_None };
+
+	/** The corner type for corner turn events. */
+	ECornerType CornerType{ ECT_Inner };
+};
+
+/**
+ * A subscription to the wall run event bus, owning a preallocated single-producer single-consumer queue of events.
+ * Events are published from the game thread and may be dequeued on any one consumer thread.
+ */
+class WALLRUNNINGTUTORIAL_API FWallRunEventSubscription
+{
+public:
+
+	explicit FWallRunEventSubscription(const uint32 Capacity);
+
+	/**
+	 * Take the oldest event from the queue. Only call from the single consuming thread.
+	 *
+	 * @param OutEvent:		[Out] The dequeued event.
+	 * @return				True if an event was dequeued.
+	 */
+	bool Dequeue(FWallRunEvent& OutEvent) { return Queue.Dequeue(OutEvent); }
+
+	/** Returns the number of events dropped since the last call because the queue was full. */
+	uint32 ConsumeNumDropped() { return NumDropped.exchange(0, std::memory_order_relaxed); }
+
+private:
+
+	friend class UWallRunEventBusSubsystem;
+
+	/** Called by the publishing thread. Never allocates or takes a lock. */
+	void Enqueue(const FWallRunEvent& Event);
+
+	TCircularQueue<FWallRunEvent> Queue;
+
+	std::atomic<uint32> NumDropped{ 0 };
+};
+
+/**
+ * UWallRunEventBusSubsystem broadcasts wall run events from every UCustomCharacterMovementComponent in the world to any number of subscribers,
+ * such as audio, VFX, animation, analytics and AI, including ones that consume on other threads.
+ * Subscribing, unsubscribing and publishing all happen on the game thread, so publishing never needs a lock.
+ */
+UCLASS()
+class WALLRUNNINGTUTORIAL_API UWallRunEventBusSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Default number of events a subscription can queue. */
+	static constexpr uint32 DefaultSubscriptionCapacity = 1024;
+
+	/**
+	 * Add a subscriber. Game thread only. The returned subscription stays valid for as long as it is referenced, even after unsubscribing.
+	 *
+	 * @param Capacity:		Minimum number of events the subscription can queue. The queue's storage is rounded up to a power of two, so it may hold more.
+	 * @return				The subscription to dequeue events from.
+	 */
+	TSharedRef<FWallRunEventSubscription, ESPMode::ThreadSafe> Subscribe(const uint32 Capacity = DefaultSubscriptionCapacity);
+
+	/** Remove a subscriber. Game thread only. */
+	void Unsubscribe(const TSharedRef<FWallRunEventSubscription, ESPMode::ThreadSafe>& Subscription);
+
+	/** Publish an event to every subscriber. Game thread only. */
+	void Publish(const FWallRunEvent& Event);
+
+	/** Returns true if anything is subscribed to the bus. */
+	FORCEINLINE bool HasSubscribers() const { return !Subscriptions.IsEmpty(); }
+
+private:
+
+	TArray<TSharedRef<FWallRunEventSubscription, ESPMode::ThreadSafe>> Subscriptions;
+};
@@ -0,0 +1,384 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WallRunNetworkPrediction.h"
+#include "NetworkPredictionModelDefRegistry.h"
+#include "NetworkPredictionReplicationProxy.h"
+#include "WallRunPredictionComponent.h"
+#include "WallRunCollisionChannels.h"
+#include "WallrunnableInterface.h"
+
+NP_MODEL_REGISTER(FWallRunModelDef);
+
+/** Surfaces with a normal Z at or above this are treated as floors rather than walls. */
+static constexpr double WallRunWalkableFloorZ = 0.71;
+
+/** Amount the capsule is shrunk by when sweeping along a wall, so the wall it's running along doesn't block the move. */
+static constexpr float WallRunSweepSkin = 1.0f;
+
+//////////////////////////////////////////////////////////////////////////
+// FWallRunInputCmd
+
+void FWallRunInputCmd::NetSerialize(const FNetSerializeParams& P)
+{
+	P.Ar << MoveInput;
+	P.Ar << bWantsToWallRun;
+	P.Ar << bJumpPressed;
+}
+
+void FWallRunInputCmd::ToString(FAnsiStringBuilderBase& Out) const
+{
+	Out.Appendf("MoveInput: X=%.2f Y=%.2f Z=%.2f\n", MoveInput.X, MoveInput.Y, MoveInput.Z);
+	Out.Appendf("bWantsToWallRun: %d\n", bWantsToWallRun);
+	Out.Appendf("bJumpPressed: %d\n", bJumpPressed);
+}
+
+void FWallRunInputCmd::Interpolate(const FWallRunInputCmd* From, const FWallRunInputCmd* To, float PCT)
+{
+	MoveInput = FMath::Lerp(From->MoveInput, To->MoveInput, PCT);
+	bWantsToWallRun = To->bWantsToWallRun;
+	bJumpPressed = To->bJumpPressed;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FWallRunSyncState
+
+void FWallRunSyncState::NetSerialize(const FNetSerializeParams& P)
+{
+	P.Ar << Location;
+	P.Ar << Rotation;
+	P.Ar << Velocity;
+	P.Ar << WallNormal;
+	P.Ar << CornerTurnTarget;
+	P.Ar << CooldownFramesRemaining;
+	P.Ar << CornerTurnFramesRemaining;
+
+	uint8 Side = WallRunSide;
+	P.Ar << Side;
+	WallRunSide = static_cast<EWallRunSide>(Side);
+
+	P.Ar << bWallRunning;
+	P.Ar << bOnGround;
+}
+
+void FWallRunSyncState::ToString(FAnsiStringBuilderBase& Out) const
+{
+	Out.Appendf("Location: X=%.2f Y=%.2f Z=%.2f\n", Location.X, Location.Y, Location.Z);
+	Out.Appendf("Velocity: X=%.2f Y=%.2f Z=%.2f\n", Velocity.X, Velocity.Y, Velocity.Z);
+	Out.Appendf("WallNormal: X=%.2f Y=%.2f Z=%.2f\n", WallNormal.X, WallNormal.Y, WallNormal.Z);
+	Out.Appendf("CooldownFramesRemaining: %d\n", CooldownFramesRemaining);
+	Out.Appendf("CornerTurnFramesRemaining: %d\n", CornerTurnFramesRemaining);
+	Out.Appendf("WallRunSide: %d\n", (int32)WallRunSide);
+	Out.Appendf("bWallRunning: %d\n", bWallRunning);
+	Out.Appendf("bOnGround: %d\n", bOnGround);
+}
+
+void FWallRunSyncState::Interpolate(const FWallRunSyncState* From, const FWallRunSyncState* To, float PCT)
+{
+	*this = *To;
+
+	Location = FMath::Lerp(From->Location, To->Location, PCT);
+	Rotation = FQuat::Slerp(From->Rotation, To->Rotation, PCT);
+	Velocity = FMath::Lerp(From->Velocity, To->Velocity, PCT);
+}
+
+bool FWallRunSyncState::ShouldReconcile(const FWallRunSyncState& AuthorityState) const
+{
+	static constexpr double LocationTolerance = 1.0;
+	static constexpr double VelocityTolerance = 1.0;
+
+	return !Location.Equals(AuthorityState.Location, LocationTolerance)
+		|| !Velocity.Equals(AuthorityState.Velocity, VelocityTolerance)
+		|| bWallRunning != AuthorityState.bWallRunning
+		|| WallRunSide != AuthorityState.WallRunSide
+		|| CooldownFramesRemaining != AuthorityState.CooldownFramesRemaining
+		|| CornerTurnFramesRemaining != AuthorityState.CornerTurnFramesRemaining;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FWallRunAuxState
+
+void FWallRunAuxState::NetSerialize(const FNetSerializeParams& P)
+{
+	P.Ar << WallRunSpeed;
+	P.Ar << MaxWalkSpeed;
+	P.Ar << JumpZVelocity;
+	P.Ar << GravityZ;
+	P.Ar << AirControl;
+	P.Ar << CapsuleRadius;
+	P.Ar << CapsuleHalfHeight;
+	P.Ar << WallRunCooldownMS;
+	P.Ar << WallRunCornerTurnMS;
+}
+
+void FWallRunAuxState::ToString(FAnsiStringBuilderBase& Out) const
+{
+	Out.Appendf("WallRunSpeed: %.2f\n", WallRunSpeed);
+	Out.Appendf("WallRunCooldownMS: %d\n", WallRunCooldownMS);
+	Out.Appendf("WallRunCornerTurnMS: %d\n", WallRunCornerTurnMS);
+}
+
+void FWallRunAuxState::Interpolate(const FWallRunAuxState* From, const FWallRunAuxState* To, float PCT)
+{
+	*this = *To;
+}
+
+bool FWallRunAuxState::ShouldReconcile(const FWallRunAuxState& AuthorityState) const
+{
+	return WallRunSpeed != AuthorityState.WallRunSpeed
+		|| MaxWalkSpeed != AuthorityState.MaxWalkSpeed
+		|| JumpZVelocity != AuthorityState.JumpZVelocity
+		|| GravityZ != AuthorityState.GravityZ
+		|| AirControl != AuthorityState.AirControl
+		|| CapsuleRadius != AuthorityState.CapsuleRadius
+		|| CapsuleHalfHeight != AuthorityState.CapsuleHalfHeight
+		|| WallRunCooldownMS != AuthorityState.WallRunCooldownMS
+		|| WallRunCornerTurnMS != AuthorityState.WallRunCornerTurnMS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FWallRunSimulation
+
+FWallRunSimulation::FWallRunSimulation(const UWorld* InWorld, const AActor* InOwner)
+	: World(InWorld)
+	, QueryParams(SCENE_QUERY_STAT(WallRunSimulation), false, InOwner)
+{
+	/* Movable primitives aren't rolled back with the simulation, so a resimulated frame could see them somewhere else than the original frame did. */
+	QueryParams.MobilityType = EQueryMobilityType::Static;
+}
+
+void FWallRunSimulation::SimulationTick(const FNetSimTimeStep& TimeStep, const TNetSimInput<FWallRunStateTypes>& Input, const TNetSimOutput<FWallRunStateTypes>& Output)
+{
+	FWallRunSyncState& Sync = *Output.Sync;
+	Sync = *Input.Sync;
+
+	SimulateFrame(TimeStep.StepMS, *Input.Cmd, *Input.Aux, Sync);
+}
+
+void FWallRunSimulation::SimulateFrame(const int32 StepMS, const FWallRunInputCmd& Cmd, const FWallRunAuxState& Aux, FWallRunSyncState& Sync) const
+{
+	const float DeltaSeconds = static_cast<float>(StepMS) / 1000.0f;
+
+	if (Sync.CooldownFramesRemaining > 0)
+	{
+		--Sync.CooldownFramesRemaining;
+	}
+
+	if (Sync.bWallRunning)
+	{
+		TickWallRun(DeltaSeconds, StepMS, Cmd, Aux, Sync);
+	}
+	else
+	{
+		TickAirAndGround(DeltaSeconds, Cmd, Aux, Sync);
+	}
+}
+
+void FWallRunSimulation::TickAirAndGround(const float DeltaSeconds, const FWallRunInputCmd& Cmd, const FWallRunAuxState& Aux, FWallRunSyncState& Sync) const
+{
+	const bool bWasFalling = !Sync.bOnGround;
+
+	/* Steer towards the input direction, with reduced control while in the air. */
+
+	const FVector DesiredVelocity = Cmd.MoveInput.GetClampedToMaxSize(1.0) * Aux.MaxWalkSpeed;
+	const float Control = Sync.bOnGround ? 1.0f : Aux.AirControl;
+
+	Sync.Velocity.X = FMath::Lerp(Sync.Velocity.X, DesiredVelocity.X, Control);
+	Sync.Velocity.Y = FMath::Lerp(Sync.Velocity.Y, DesiredVelocity.Y, Control);
+
+	if (Sync.bOnGround && Cmd.bJumpPressed)
+	{
+		Sync.Velocity.Z = Aux.JumpZVelocity;
+	}
+
+	Sync.Velocity.Z += Aux.GravityZ * DeltaSeconds;
+	Sync.bOnGround = false;
+
+	/* Sweep the capsule along the velocity, sliding along whatever it hits once. */
+
+	const FCollisionShape CapsuleShape = FCollisionShape::MakeCapsule(Aux.CapsuleRadius, Aux.CapsuleHalfHeight);
+	FVector Delta = Sync.Velocity * DeltaSeconds;
+
+	for (int32 Iteration = 0; Iteration < 2 && !Delta.IsNearlyZero(); ++Iteration)
+	{
+		FHitResult Hit{};
+		World->SweepSingleByChannel(Hit, Sync.Location, Sync.Location + Delta, FQuat::Identity, ECC_Pawn, CapsuleShape, QueryParams);
+
+		if (!Hit.bBlockingHit)
+		{
+			Sync.Location += Delta;
+			break;
+		}
+
+		Sync.Location = Hit.Location;
+
+		if (Hit.ImpactNormal.Z >= WallRunWalkableFloorZ)
+		{
+			Sync.bOnGround = true;
+			Sync.Velocity.Z = 0.0;
+		}
+		else if (bWasFalling && Cmd.bWantsToWallRun && Sync.CooldownFramesRemaining == 0 && Cast<IWallrunnableInterface>(Hit.GetActor()))
+		{
+			/* Save what side the wall is relative to the character, then align with the wall. */
+
+			Sync.WallNormal = Hit.ImpactNormal.GetSafeNormal2D();
+			Sync.WallRunSide = (FVector::DotProduct(Sync.Rotation.GetRightVector(), Sync.WallNormal) > 0.0) ? EWRS_LeftSide : EWRS_RightSide;
+			Sync.Rotation = CalcWallRunRotation(Sync);
+			Sync.Velocity = Sync.Rotation.GetForwardVector() * Aux.WallRunSpeed;
+			Sync.bWallRunning = true;
+			return;
+		}
+
+		Delta = FVector::VectorPlaneProject(Delta * (1.0 - Hit.Time), Hit.Normal);
+		Sync.Velocity = FVector::VectorPlaneProject(Sync.Velocity, Hit.Normal);
+	}
+
+	/* Face the direction of movement. */
+
+	if (Sync.Velocity.SizeSquared2D() > UE_KINDA_SMALL_NUMBER)
+	{
+		Sync.Rotation = FRotator(0.0, Sync.Velocity.Rotation().Yaw, 0.0).Quaternion();
+	}
+}
+
+void FWallRunSimulation::TickWallRun(const float DeltaSeconds, const int32 StepMS, const FWallRunInputCmd& Cmd, const FWallRunAuxState& Aux, FWallRunSyncState& Sync) const
+{
+	if (Sync.CornerTurnFramesRemaining > 0)
+	{
+		/* Cover a fraction of the remaining turn each frame so that the turn completes exactly on its last frame. */
+
+		const float Alpha = 1.0f / Sync.CornerTurnFramesRemaining;
+		Sync.Location = FMath::Lerp(Sync.Location, Sync.CornerTurnTarget, Alpha);
+		Sync.Rotation = FQuat::Slerp(Sync.Rotation, CalcWallRunRotation(Sync), Alpha);
+		--Sync.CornerTurnFramesRemaining;
+		return;
+	}
+
+	if (!Cmd.bWantsToWallRun)
+	{
+		EndWallRun(StepMS, Aux, Sync);
+		return;
+	}
+
+	if (Cmd.bJumpPressed)
+	{
+		Sync.Velocity.Z = Aux.JumpZVelocity;
+		EndWallRun(StepMS, Aux, Sync);
+		return;
+	}
+
+	const double WallSearchTraceDistance = Aux.CapsuleRadius * 2.0;
+	const FVector Forward = Sync.Rotation.GetForwardVector();
+	const FVector ToWall = (Sync.WallRunSide == EWRS_LeftSide) ? -Sync.Rotation.GetRightVector() : Sync.Rotation.GetRightVector();
+
+	/* Turns the character around the corner of the hit wall if the player is steering towards it, otherwise ends the wall run. */
+	auto TurnAroundCorner = [&Sync, &Cmd, &Aux, StepMS](const FHitResult& CornerHit)
+	{
+		FWallRunSyncState TurnedState = Sync;
+		TurnedState.WallNormal = CornerHit.ImpactNormal.GetSafeNormal2D();
+
+		const FVector CornerTurnDirection = CalcWallRunRotation(TurnedState).GetForwardVector();
+
+		if (FVector::DotProduct(CornerTurnDirection, Cmd.MoveInput) <= 0.0)
+		{
+			EndWallRun(StepMS, Aux, Sync);
+			return;
+		}
+
+		Sync.WallNormal = TurnedState.WallNormal;
+		Sync.CornerTurnTarget = CornerHit.ImpactPoint + Sync.WallNormal * Aux.CapsuleRadius;
+		Sync.CornerTurnTarget.Z = Sync.Location.Z;
+		Sync.CornerTurnFramesRemaining = FMath::Max(1, FMath::DivideAndRoundUp(Aux.WallRunCornerTurnMS, StepMS));
+		Sync.Velocity = FVector::ZeroVector;
+	};
+
+	FHitResult Hit{};
+
+	/* Check if the character is at an inner corner. */
+
+	if (TraceWall(Sync.Location, Sync.Location + Forward * WallSearchTraceDistance, Hit))
+	{
+		TurnAroundCorner(Hit);
+		return;
+	}
+
+	/* Check if a wall is besides the character, then move the character along the wall if there is one. */
+
+	if (TraceWall(Sync.Location, Sync.Location + ToWall * WallSearchTraceDistance, Hit))
+	{
+		Sync.WallNormal = Hit.ImpactNormal.GetSafeNormal2D();
+
+		/* Keep the character a capsule radius away from the wall so it doesn't drift off curved walls at high speeds. */
+		const double DistanceToWall = FVector::DotProduct(Sync.Location - Hit.ImpactPoint, Sync.WallNormal);
+		Sync.Location -= Sync.WallNormal * (DistanceToWall - Aux.CapsuleRadius);
+
+		static constexpr float WallRunRotationInterpSpeed = 5.0f;
+		Sync.Rotation = FMath::QInterpTo(Sync.Rotation, CalcWallRunRotation(Sync), DeltaSeconds, WallRunRotationInterpSpeed);
+
+		Sync.Velocity = Sync.Rotation.GetForwardVector() * Aux.WallRunSpeed;
+
+		/* Sweep the capsule like the movement component's wall run move, so the character can't pass through anything ahead. */
+
+		const FVector Delta = Sync.Velocity * DeltaSeconds;
+		const FCollisionShape CapsuleShape = FCollisionShape::MakeCapsule(Aux.CapsuleRadius - WallRunSweepSkin, Aux.CapsuleHalfHeight - WallRunSweepSkin);
+
+		if (!World->SweepSingleByChannel(Hit, Sync.Location, Sync.Location + Delta, FQuat::Identity, ECC_Pawn, CapsuleShape, QueryParams))
+		{
+			Sync.Location += Delta;
+			return;
+		}
+
+		Sync.Location = Hit.Location;
+
+		/* Wall traces only see wallrunnable surfaces, so anything else ahead only shows up as a blocked move. Turn around it if it can be wall run on, otherwise end the wall run. */
+
+		static constexpr double BlockedMoveNormalThreshold = -0.5;
+
+		if (FVector::DotProduct(Hit.Normal, Sync.Velocity.GetSafeNormal()) < BlockedMoveNormalThreshold)
+		{
+			if (Cast<IWallrunnableInterface>(Hit.GetActor()))
+			{
+				TurnAroundCorner(Hit);
+			}
+			else
+			{
+				EndWallRun(StepMS, Aux, Sync);
+			}
+		}
+
+		return;
+	}
+
+	/* Check if the character is at an outer corner. */
+
+	const FVector OuterCornerTraceStart = Sync.Location + ToWall * WallSearchTraceDistance;
+
+	if (TraceWall(OuterCornerTraceStart, OuterCornerTraceStart - Forward * WallSearchTraceDistance, Hit))
+	{
+		TurnAroundCorner(Hit);
+		return;
+	}
+
+	EndWallRun(StepMS, Aux, Sync);
+}
+
+void FWallRunSimulation::EndWallRun(const int32 StepMS, const FWallRunAuxState& Aux, FWallRunSyncState& Sync)
+{
+	Sync.bWallRunning = false;
+	Sync.WallRunSide = EWRS_None;
+	Sync.CornerTurnFramesRemaining = 0;
+	Sync.CooldownFramesRemaining = FMath::DivideAndRoundUp(Aux.WallRunCooldownMS, StepMS);
+}
+
+FQuat FWallRunSimulation::CalcWallRunRotation(const FWallRunSyncState& Sync)
+{
+	const FVector Y = (Sync.WallRunSide == EWRS_LeftSide) ? Sync.WallNormal : -Sync.WallNormal;
+	const FVector X = FVector::CrossProduct(Y, FVector::UpVector).GetSafeNormal();
+
+	return FRotationMatrix::MakeFromXY(X, Y).ToQuat();
+}
+
+bool FWallRunSimulation::TraceWall(const FVector& Start, const FVector& End, FHitResult& OutHit) const
+{
+	return World->LineTraceSingleByChannel(OutHit, Start, End, ECC_WallRun, QueryParams);
+}
@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NetworkPredictionModelDef.h"
+#include "NetworkPredictionSimulation.h"
+#include "NetworkPredictionStateTypes.h"
+#include "NetworkPredictionTickState.h"
+#include "CustomCharacterMovementComponent.h"
+
+class UWallRunPredictionComponent;
+struct FNetSerializeParams;
+
+/** Input produced by the controlling machine every simulation frame. */
+struct FWallRunInputCmd
+{
+	/** World space movement input. */
+	FVector MoveInput{};
+
+	/** If true, the player is attempting to wall run. */
+	bool bWantsToWallRun = true;
+
+	/** If true, the player pressed jump this frame. */
+	bool bJumpPressed = false;
+
+	void NetSerialize(const FNetSerializeParams& P);
+	void ToString(FAnsiStringBuilderBase& Out) const;
+	void Interpolate(const FWallRunInputCmd* From, const FWallRunInputCmd* To, float PCT);
+};
+
+/**
+ * Wall run state that changes every frame. Plain data so that snapshotting and restoring it for rollbacks is a copy.
+ * Cooldowns and corner turns are counted in simulation frames instead of timers or latent actions.
+ */
+struct FWallRunSyncState
+{
+	FVector Location{};
+	FQuat Rotation{ FQuat::Identity };
+	FVector Velocity{};
+
+	/** Normal of the wall that the character is running on. */
+	FVector WallNormal{};
+
+	/** Location the character moves to while turning around a corner. */
+	FVector CornerTurnTarget{};
+
+	/** Remaining simulation frames before the character can wall run again. */
+	int32 CooldownFramesRemaining = 0;
+
+	/** Remaining simulation frames of the current corner turn. */
+	int32 CornerTurnFramesRemaining = 0;
+
+	/** Which side of the character the wall is on. */
+	EWallRunSide WallRunSide{ EWRS_None };
+
+	bool bWallRunning = false;
+	bool bOnGround = false;
+
+	void NetSerialize(const FNetSerializeParams& P);
+	void ToString(FAnsiStringBuilderBase& Out) const;
+	void Interpolate(const FWallRunSyncState* From, const FWallRunSyncState* To, float PCT);
+	bool ShouldReconcile(const FWallRunSyncState& AuthorityState) const;
+};
+
+/** Wall run tuning that rarely changes. Durations are in milliseconds and converted to simulation frames when they start. */
+struct FWallRunAuxState
+{
+	float WallRunSpeed = 550.0f;
+	float MaxWalkSpeed = 500.0f;
+	float JumpZVelocity = 700.0f;
+	float GravityZ = -980.0f;
+	float AirControl = 0.35f;
+	float CapsuleRadius = 42.0f;
+	float CapsuleHalfHeight = 96.0f;
+	int32 WallRunCooldownMS = 700;
+	int32 WallRunCornerTurnMS = 300;
+
+	void NetSerialize(const FNetSerializeParams& P);
+	void ToString(FAnsiStringBuilderBase& Out) const;
+	void Interpolate(const FWallRunAuxState* From, const FWallRunAuxState* To, float PCT);
+	bool ShouldReconcile(const FWallRunAuxState& AuthorityState) const;
+};
+
+using FWallRunStateTypes = TNetworkPredictionStateTypes<FWallRunInputCmd, FWallRunSyncState, FWallRunAuxState>;
+
+/**
+ * FWallRunSimulation advances the wall run state by one fixed simulation frame. The output only depends on the input states and the static world,
+ * so any frame can be resimulated after a correction. All queries are restricted to static geometry, so other pawns and movable walls, whose
+ * positions aren't part of the rolled back state, are ignored by the simulation.
+ */
+class FWallRunSimulation
+{
+public:
+
+	FWallRunSimulation(const UWorld* InWorld, const AActor* InOwner);
+
+	void SimulationTick(const FNetSimTimeStep& TimeStep, const TNetSimInput<FWallRunStateTypes>& Input, const TNetSimOutput<FWallRunStateTypes>& Output);
+
+	/** Advances Sync by one simulation frame of StepMS milliseconds. */
+	void SimulateFrame(const int32 StepMS, const FWallRunInputCmd& Cmd, const FWallRunAuxState& Aux, FWallRunSyncState& Sync) const;
+
+private:
+
+	/** Moves the character while it's not wall running, entering a wall run if it hits a wallrunnable wall. */
+	void TickAirAndGround(const float DeltaSeconds, const FWallRunInputCmd& Cmd, const FWallRunAuxState& Aux, FWallRunSyncState& Sync) const;
+
+	/** Moves the character along the wall it's running on, turning it around corners or ending the wall run. */
+	void TickWallRun(const float DeltaSeconds, const int32 StepMS, const FWallRunInputCmd& Cmd, const FWallRunAuxState& Aux, FWallRunSyncState& Sync) const;
+
+	/** Ends the wall run and starts the cooldown. */
+	static void EndWallRun(const int32 StepMS, const FWallRunAuxState& Aux, FWallRunSyncState& Sync);
+
+	/** Returns the rotation that aligns the character with the wall. */
+	static FQuat CalcWallRunRotation(const FWallRunSyncState& Sync);
+
+	/** Traces the wall run channel against static geometry, ignoring the owning actor. */
+	bool TraceWall(const FVector& Start, const FVector& End, FHitResult& OutHit) const;
+
+	const UWorld* World = nullptr;
+
+	FCollisionQueryParams QueryParams;
+};
+
+/** Network Prediction model definition for wall running on the fixed tick. */
+class FWallRunModelDef : public FNetworkPredictionModelDef
+{
+public:
+
+	NP_MODEL_BODY();
+
+	using Simulation = FWallRunSimulation;
+	using StateTypes = FWallRunStateTypes;
+	using Driver = UWallRunPredictionComponent;
+
+	static const TCHAR* GetName() { return TEXT("WallRun"); }
+	static constexpr int32 GetSortPriority() { return (int32)ENetworkPredictionSortPriority::First; }
+};
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WallRunPredictionComponent.h"
+#include <Components/CapsuleComponent.h>
+#include <GameFramework/Actor.h>
+#include "NetworkPredictionProxyInit.h"
+#include "WallRunNetworkPrediction.h"
+
+UWallRunPredictionComponent::UWallRunPredictionComponent()
+{
+	SetIsReplicatedByDefault(true);
+}
+
+void UWallRunPredictionComponent::InitializeNetworkPredictionProxy()
+{
+	OwnedWallRunSimulation = MakePimpl<FWallRunSimulation>(GetWorld(), GetOwner());
+	NetworkPredictionProxy.Init<FWallRunModelDef>(GetWorld(), GetReplicationProxies(), OwnedWallRunSimulation.Get(), this);
+}
+
+void UWallRunPredictionComponent::InitializeSimulationState(FWallRunSyncState* OutSync, FWallRunAuxState* OutAux)
+{
+	const AActor* const Owner = GetOwner();
+	check(Owner);
+
+	OutSync->Location = Owner->GetActorLocation();
+	OutSync->Rotation = Owner->GetActorQuat();
+
+	OutAux->WallRunSpeed = WallRunSpeed;
+	OutAux->WallRunCooldownMS = FMath::RoundToInt(WallRunCooldownDuration * 1000.0f);
+	OutAux->WallRunCornerTurnMS = FMath::RoundToInt(WallRunCornerTurnDuration * 1000.0f);
+
+	if (const UCapsuleComponent* const Capsule = Cast<UCapsuleComponent>(Owner->GetRootComponent()))
+	{
+		OutAux->CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+		OutAux->CapsuleHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	}
+
+	if (const UWorld* const World = GetWorld())
+	{
+		OutAux->GravityZ = World->GetGravityZ();
+	}
+}
+
+void UWallRunPredictionComponent::ProduceInput(const int32 DeltaTimeMS, FWallRunInputCmd* OutCmd)
+{
+	OutCmd->MoveInput = PendingMoveInput;
+	OutCmd->bWantsToWallRun = bWantsToWallRun;
+	OutCmd->bJumpPressed = bPendingJump;
+
+	PendingMoveInput = FVector::ZeroVector;
+	bPendingJump = false;
+}
+
+void UWallRunPredictionComponent::RestoreFrame(const FWallRunSyncState* SyncState, const FWallRunAuxState* AuxState)
+{
+	ApplySyncState(*SyncState);
+}
+
+void UWallRunPredictionComponent::FinalizeFrame(const FWallRunSyncState* SyncState, const FWallRunAuxState* AuxState)
+{
+	ApplySyncState(*SyncState);
+
+	bWallRunning = SyncState->bWallRunning;
+	WallRunSide = SyncState->WallRunSide;
+}
+
+void UWallRunPredictionComponent::ApplySyncState(const FWallRunSyncState& SyncState)
+{
+	if (AActor* const Owner = GetOwner())
+	{
+		Owner->SetActorLocationAndRotation(SyncState.Location, SyncState.Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	}
+}
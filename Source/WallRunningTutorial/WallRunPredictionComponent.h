@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NetworkPredictionComponent.h"
+#include "Templates/PimplPtr.h"
+#include "CustomCharacterMovementComponent.h"
+#include "WallRunPredictionComponent.generated.h"
+
+class FWallRunSimulation;
+struct FWallRunInputCmd;
+struct FWallRunSyncState;
+struct FWallRunAuxState;
+
+/**
+ * UWallRunPredictionComponent drives wall running through the Network Prediction plugin's fixed tick model, for modes that need rollback-correct wall runs.
+ * It is standalone: it moves its owner directly and shares no state with UCustomCharacterMovementComponent, and AWallRunningTutorialCharacter doesn't use it.
+ * It is meant for pawns that don't also use UCustomCharacterMovementComponent for wall running.
+ * The owner feeds it input with SetMoveInput, SetWantsToWallRun and Jump.
+ */
+UCLASS(ClassGroup = Movement, meta = (BlueprintSpawnableComponent))
+class WALLRUNNINGTUTORIAL_API UWallRunPredictionComponent : public UNetworkPredictionComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UWallRunPredictionComponent();
+
+	/** Sets the world space movement input used for the next produced input command. */
+	UFUNCTION(BlueprintCallable)
+	void SetMoveInput(const FVector& InMoveInput) { PendingMoveInput = InMoveInput; }
+
+	/** Sets whether the player is attempting to wall run. */
+	UFUNCTION(BlueprintCallable)
+	void SetWantsToWallRun(bool bInWantsToWallRun) { bWantsToWallRun = bInWantsToWallRun; }
+
+	/** Requests a jump in the next produced input command. */
+	UFUNCTION(BlueprintCallable)
+	void Jump() { bPendingJump = true; }
+
+	/** Returns true if the most recently finalized frame is wall running. */
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE bool IsWallRunning() const { return bWallRunning; }
+
+	UFUNCTION(BlueprintCallable)
+	FORCEINLINE EWallRunSide GetWallRunSide() const { return WallRunSide; }
+
+	/** Called by the Network Prediction plugin to create the initial simulation state. */
+	void InitializeSimulationState(FWallRunSyncState* OutSync, FWallRunAuxState* OutAux);
+
+	/** Called by the Network Prediction plugin on the controlling machine to produce the input command for the next frame. */
+	void ProduceInput(const int32 DeltaTimeMS, FWallRunInputCmd* OutCmd);
+
+	/** Called by the Network Prediction plugin before resimulating from a restored frame. */
+	void RestoreFrame(const FWallRunSyncState* SyncState, const FWallRunAuxState* AuxState);
+
+	/** Called by the Network Prediction plugin to present the latest simulated frame. */
+	void FinalizeFrame(const FWallRunSyncState* SyncState, const FWallRunAuxState* AuxState);
+
+protected:
+
+	virtual void InitializeNetworkPredictionProxy() override;
+
+private:
+
+	/** Applies a simulation frame's location and rotation to the owner. */
+	void ApplySyncState(const FWallRunSyncState& SyncState);
+
+	/** The simulation owned by this component. */
+	TPimplPtr<FWallRunSimulation> OwnedWallRunSimulation;
+
+	/** Movement input accumulated since the last produced input command. */
+	FVector PendingMoveInput{};
+
+	/** If true, a jump was requested since the last produced input command. */
+	bool bPendingJump = false;
+
+	/** If true, the player is attempting to wall run. */
+	bool bWantsToWallRun = true;
+
+	/** Wall running state of the most recently finalized frame. */
+	bool bWallRunning = false;
+
+	/** Wall run side of the most recently finalized frame. */
+	EWallRunSide WallRunSide{ EWRS_None };
+
+	/** Speed that the character can wall run. */
+	UPROPERTY(EditAnywhere, Category = Movement, meta = (DisplayName = "Wall Run Speed"))
+	float WallRunSpeed = 550.0f;
+
+	/** Time to temporarily disable wall running after one has completed. Converted to simulation frames. */
+	UPROPERTY(EditAnywhere, Category = Movement, meta = (DisplayName = "Wall Run Cooldown Duration"))
+	float WallRunCooldownDuration = 0.7f;
+
+	/** The time it takes to turn around a corner for wall running. Converted to simulation frames. */
+	UPROPERTY(EditAnywhere, Category = Movement, meta = (DisplayName = "Wall Run Corner Turn Duration"))
+	float WallRunCornerTurnDuration = 0.3f;
+};
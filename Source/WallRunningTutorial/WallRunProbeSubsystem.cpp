@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WallRunProbeSubsystem.h"
+#include <Async/ParallelFor.h>
+#include <Engine/World.h>
+#include <GameFramework/PlayerController.h>
+#include "CustomCharacterMovementComponent.h"
+#include "WallRunCollisionChannels.h"
+
+void UWallRunProbeSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	NumDeferredProbes = 0;
+
+	/* Fallback traces that cost more than a whole budget are carried over, so a backlog of stale probes doesn't also get a full batch every frame. */
+	const double BudgetSeconds = FrameBudgetMs / 1000.0 - SynchronousProbeSeconds;
+	SynchronousProbeSeconds = FMath::Max(-BudgetSeconds, 0.0);
+
+	if (PendingRequests.IsEmpty()) return;
+
+	PrioritiseRequests();
+
+	const UWorld* const World = GetWorld();
+	const FCollisionQueryParams QueryParams{ SCENE_QUERY_STAT(WallRunProbe), false };
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 BatchSize = FMath::Max(ProbeBatchSize, 1);
+
+	Results.SetNum(PendingRequests.Num(), EAllowShrinking::No);
+
+	/* Nothing writes to the physics scene while the batch runs, so the traces can safely run in parallel. */
+
+	int32 NumTraced = 0;
+
+	while (NumTraced < PendingRequests.Num())
+	{
+		const int32 BatchStart = NumTraced;
+		const int32 BatchNum = FMath::Min(BatchSize, PendingRequests.Num() - BatchStart);
+
+		ParallelFor(BatchNum, [this, World, &QueryParams, BatchStart](int32 BatchIndex)
+		{
+			const FWallRunProbeRequest& Request = PendingRequests[BatchStart + BatchIndex];
+			World->LineTraceSingleByChannel(Results[BatchStart + BatchIndex], Request.Start, Request.End, ECC_WallRun, QueryParams);
+		});
+
+		NumTraced += BatchNum;
+
+		if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds) break;
+	}
+
+	for (int32 Index = 0; Index < NumTraced; ++Index)
+	{
+		const FWallRunProbeRequest& Request = PendingRequests[Index];
+
+		if (UCustomCharacterMovementComponent* const Requester = Request.Requester.Get())
+		{
+			Requester->ReceiveWallRunProbeResult(Request.Probe, Request.Generation, Request.FrameNumber, Results[Index]);
+		}
+	}
+
+	NumDeferredProbes = PendingRequests.Num() - NumTraced;
+	PendingRequests.Reset();
+}
+
+TStatId UWallRunProbeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWallRunProbeSubsystem, STATGROUP_Tickables);
+}
+
+void UWallRunProbeSubsystem::SubmitProbe(UCustomCharacterMovementComponent* Requester, const EWallRunProbe Probe, const uint32 Generation, const FVector& Start, const FVector& End)
+{
+	FWallRunProbeRequest& Request = PendingRequests.AddDefaulted_GetRef();
+	Request.Requester = Requester;
+	Request.Start = Start;
+	Request.End = End;
+	Request.Generation = Generation;
+	Request.FrameNumber = GFrameCounter;
+	Request.Probe = Probe;
+}
+
+bool UWallRunProbeSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWallRunProbeSubsystem::PrioritiseRequests()
+{
+	TArray<FVector, TInlineAllocator<4>> LocalViewLocations;
+
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* const PlayerController = Iterator->Get();
+
+		if (PlayerController && PlayerController->IsLocalController())
+		{
+			FVector ViewLocation{};
+			FRotator ViewRotation{};
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			LocalViewLocations.Add(ViewLocation);
+		}
+	}
+
+	for (FWallRunProbeRequest& Request : PendingRequests)
+	{
+		double ClosestDistance = 0.0;
+
+		if (!LocalViewLocations.IsEmpty())
+		{
+			double ClosestDistanceSquared = TNumericLimits<double>::Max();
+
+			for (const FVector& ViewLocation : LocalViewLocations)
+			{
+				ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, FVector::DistSquared(ViewLocation, Request.Start));
+			}
+
+			ClosestDistance = FMath::Sqrt(ClosestDistanceSquared);
+		}
+
+		const UCustomCharacterMovementComponent* const Requester = Request.Requester.Get();
+		const bool bApproachingCorner = Requester && Requester->IsApproachingCorner();
+
+		/* The bias still orders requests when there are no local players to measure distances from, such as on dedicated servers. */
+		Request.Priority = bApproachingCorner ? ClosestDistance * CornerPriorityScale - CornerPriorityBias : ClosestDistance;
+	}
+
+	/* Stable so that the probes of a single character stay in the order they were requested in. */
+	PendingRequests.StableSort([](const FWallRunProbeRequest& A, const FWallRunProbeRequest& B) { return A.Priority < B.Priority; });
+}
@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WallRunProbeSubsystem.generated.h"
+
+class UCustomCharacterMovementComponent;
+enum EWallRunProbe : uint8;
+
+/** A wall run probe queued by a character for the next batch. */
+struct FWallRunProbeRequest
+{
+	/** The movement component that requested the probe and receives the result. */
+	TWeakObjectPtr<UCustomCharacterMovementComponent> Requester;
+
+	/** Start location of the probe. */
+	FVector Start{};
+
+	/** End location of the probe. */
+	FVector End{};
+
+	/** The requester's probe generation at the time of the request. */
+	uint32 Generation = 0;
+
+	/** Frame number that the probe was requested on. */
+	uint64 FrameNumber = 0;
+
+	/** Priority of the request. Lower values are traced first. */
+	double Priority = 0.0;
+
+	/** The probe that was requested. */
+	EWallRunProbe Probe{};
+};
+
+/**
+ * UWallRunProbeSubsystem collects the wall run probes of every UCustomCharacterMovementComponent in the world and traces them in one batch per frame.
+ * Batches are fanned out with ParallelFor over the read-only physics scene until the per-frame time budget is spent. Requests that don't fit in the budget
+ * are dropped, and their characters keep using their cached results until a later frame traces them. Characters whose cached results get too old trace
+ * synchronously instead, and that time is charged to the next batch's budget.
+ *
+ * Only characters whose moves aren't predicted use the scheduler, such as AI and characters controlled on the server itself.
+ */
+UCLASS(config = Game)
+class WALLRUNNINGTUTORIAL_API UWallRunProbeSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Queue a wall run probe for the next batch.
+	 *
+	 * @param Requester:		The movement component that receives the result.
+	 * @param Probe:			The probe that is requested.
+	 * @param Generation:		The requester's current probe generation.
+	 * @param Start:			Start location of the probe.
+	 * @param End:				End location of the probe.
+	 */
+	void SubmitProbe(UCustomCharacterMovementComponent* Requester, const EWallRunProbe Probe, const uint32 Generation, const FVector& Start, const FVector& End);
+
+	/**
+	 * Charge a synchronous fallback trace to the next batch's time budget.
+	 *
+	 * @param Seconds:			Time that the trace took.
+	 */
+	FORCEINLINE void ChargeSynchronousProbe(const double Seconds) { SynchronousProbeSeconds += Seconds; }
+
+	/** Returns the number of requests that didn't fit in the last frame's time budget. */
+	FORCEINLINE int32 GetNumDeferredProbes() const { return NumDeferredProbes; }
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Sorts the pending requests by distance to the closest local player, with requests from characters approaching a corner moved forward. */
+	void PrioritiseRequests();
+
+private:
+
+	/** Requests queued since the last batch. */
+	TArray<FWallRunProbeRequest> PendingRequests;
+
+	/** Results of the requests in PendingRequests. Kept between frames to avoid reallocating. */
+	TArray<FHitResult> Results;
+
+	/** Number of requests that didn't fit in the last frame's time budget. */
+	int32 NumDeferredProbes = 0;
+
+	/** Time spent on synchronous fallback traces that hasn't been taken out of a batch's budget yet. */
+	double SynchronousProbeSeconds = 0.0;
+
+	/** Time in milliseconds that the batch may spend tracing each frame. At least one batch is always traced. */
+	UPROPERTY(Config)
+	float FrameBudgetMs = 0.5f;
+
+	/** Number of probes traced in parallel before checking the time budget again. */
+	UPROPERTY(Config)
+	int32 ProbeBatchSize = 32;
+
+	/** Scale applied to the priority distance of characters approaching a corner. Lower values make those requests more urgent. */
+	UPROPERTY(Config)
+	float CornerPriorityScale = 0.25f;
+
+	/** Distance subtracted from the priority of characters approaching a corner, so they are traced before characters this much closer that aren't. */
+	UPROPERTY(Config)
+	float CornerPriorityBias = 1000.0f;
+};
@@ -0,0 +1,263 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WallRunTelemetry.h"
+#include <atomic>
+#include <Containers/CircularQueue.h>
+#include <HAL/PlatformFileManager.h>
+#include <HAL/Runnable.h>
+#include <HAL/RunnableThread.h>
+#include <Misc/DateTime.h>
+#include <Misc/Paths.h>
+#include <Misc/ScopeLock.h>
+
+DEFINE_LOG_CATEGORY_STATIC(LogWallRunTelemetry, Log, All);
+
+namespace WallRunTelemetry
+{
+	/** Time between flushes of the background writer. */
+	static constexpr float FlushIntervalSeconds = 0.1f;
+
+	/** Ring buffer owned by a single producing thread and drained by the background writer. */
+	struct FThreadBuffer
+	{
+		TCircularQueue<FWallRunTelemetryRecord> Queue{ FWallRunTelemetry::ThreadBufferCapacity };
+
+		/** Number of records dropped because the queue was full. */
+		std::atomic<uint32> NumDropped{ 0 };
+	};
+
+	/** Every thread buffer ever registered. Buffers are never freed, so the thread local pointers to them stay valid for the lifetime of the process. */
+	static TArray<TUniquePtr<FThreadBuffer>> ThreadBuffers;
+
+	/** Guards ThreadBuffers. Only taken when a thread records its first event and when the writer flushes. */
+	static FCriticalSection ThreadBuffersLock;
+
+	static thread_local FThreadBuffer* LocalThreadBuffer = nullptr;
+
+	static std::atomic<bool> bEnabled{ false };
+
+	/** Records dropped since the process started, counted by the writer as it drains the thread buffers. */
+	static std::atomic<uint64> TotalNumDropped{ 0 };
+
+	static FThreadBuffer& GetLocalThreadBuffer()
+	{
+		if (!LocalThreadBuffer)
+		{
+			FScopeLock Lock(&ThreadBuffersLock);
+			LocalThreadBuffer = ThreadBuffers.Add_GetRef(MakeUnique<FThreadBuffer>()).Get();
+		}
+
+		return *LocalThreadBuffer;
+	}
+
+	/** Background thread that drains the thread buffers into rolling files. */
+	class FWriter : public FRunnable
+	{
+	public:
+
+		FWriter(const FString& InDirectory, const int64 InMaxFileSizeBytes, const int32 InMaxFiles)
+			: Directory(InDirectory)
+			, SessionName(FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")))
+			, MaxFileSizeBytes(InMaxFileSizeBytes)
+			, MaxFiles(FMath::Max(InMaxFiles, 1))
+		{
+		}
+
+		virtual uint32 Run() override
+		{
+			while (!bStopping.load(std::memory_order_acquire))
+			{
+				Flush();
+				FPlatformProcess::Sleep(FlushIntervalSeconds);
+			}
+
+			Flush();
+			CloseFile();
+
+			return 0;
+		}
+
+		virtual void Stop() override
+		{
+			bStopping.store(true, std::memory_order_release);
+		}
+
+		/** Drains the thread buffers into the current file. Called by the writer thread, and by FWallRunTelemetry::Flush on the calling thread. */
+		void Flush()
+		{
+			FScopeLock FlushScopeLock(&FlushLock);
+
+			PendingRecords.Reset();
+
+			{
+				FScopeLock Lock(&ThreadBuffersLock);
+
+				for (const TUniquePtr<FThreadBuffer>& ThreadBuffer : ThreadBuffers)
+				{
+					FWallRunTelemetryRecord Record{};
+
+					while (ThreadBuffer->Queue.Dequeue(Record))
+					{
+						PendingRecords.Add(Record);
+					}
+
+					if (const uint32 NumDropped = ThreadBuffer->NumDropped.exchange(0, std::memory_order_relaxed))
+					{
+						TotalNumDropped.fetch_add(NumDropped, std::memory_order_relaxed);
+						UE_LOG(LogWallRunTelemetry, Warning, TEXT("Dropped %u telemetry record(s) because a thread buffer was full."), NumDropped);
+					}
+				}
+			}
+
+			if (PendingRecords.IsEmpty()) return;
+
+			const int64 NumBytes = PendingRecords.Num() * sizeof(FWallRunTelemetryRecord);
+
+			if (!File || FileSizeBytes + NumBytes > MaxFileSizeBytes)
+			{
+				RollFile();
+			}
+
+			if (File)
+			{
+				File->Write(reinterpret_cast<const uint8*>(PendingRecords.GetData()), NumBytes);
+				FileSizeBytes += NumBytes;
+			}
+		}
+
+	private:
+
+		void RollFile()
+		{
+			CloseFile();
+
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+			PlatformFile.CreateDirectoryTree(*Directory);
+
+			/* Keep at most MaxFiles files per session by deleting the oldest one. */
+			if (FileIndex >= MaxFiles)
+			{
+				PlatformFile.DeleteFile(*GetFilePath(FileIndex - MaxFiles));
+			}
+
+			const FString FilePath = GetFilePath(FileIndex++);
+			File.Reset(PlatformFile.OpenWrite(*FilePath));
+
+			if (!File)
+			{
+				UE_LOG(LogWallRunTelemetry, Error, TEXT("Failed to open telemetry file '%s'."), *FilePath);
+				return;
+			}
+
+			FWallRunTelemetryFileHeader Header{};
+			Header.Magic = WallRunTelemetryMagic;
+			Header.Version = WallRunTelemetryVersion;
+			Header.RecordSize = sizeof(FWallRunTelemetryRecord);
+
+			File->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+			FileSizeBytes = sizeof(Header);
+		}
+
+		void CloseFile()
+		{
+			if (File)
+			{
+				File->Flush();
+				File.Reset();
+			}
+		}
+
+		FString GetFilePath(const int32 Index) const
+		{
+			return FPaths::Combine(Directory, FString::Printf(TEXT("WallRun_%s_%03d.wrtl"), *SessionName, Index));
+		}
+
+		const FString Directory;
+		const FString SessionName;
+		const int64 MaxFileSizeBytes;
+		const int32 MaxFiles;
+
+		TUniquePtr<IFileHandle> File;
+		int64 FileSizeBytes = 0;
+		int32 FileIndex = 0;
+
+		/** Records drained from the thread buffers during a flush. Kept between flushes to avoid reallocating. */
+		TArray<FWallRunTelemetryRecord> PendingRecords;
+
+		/** Guards the file and PendingRecords, as flushes can come from outside the writer thread. */
+		FCriticalSection FlushLock;
+
+		std::atomic<bool> bStopping{ false };
+	};
+
+	static TUniquePtr<FWriter> Writer;
+	static TUniquePtr<FRunnableThread> WriterThread;
+}
+
+void FWallRunTelemetry::Start(const FString& Directory, const int64 MaxFileSizeBytes, const int32 MaxFiles)
+{
+	using namespace WallRunTelemetry;
+
+	if (Writer) return;
+
+	Writer = MakeUnique<FWriter>(Directory, MaxFileSizeBytes, MaxFiles);
+	WriterThread.Reset(FRunnableThread::Create(Writer.Get(), TEXT("WallRunTelemetryWriter"), 0, TPri_BelowNormal));
+
+	bEnabled.store(true, std::memory_order_release);
+
+	UE_LOG(LogWallRunTelemetry, Log, TEXT("Writing wall run telemetry to '%s'."), *Directory);
+}
+
+void FWallRunTelemetry::Stop()
+{
+	using namespace WallRunTelemetry;
+
+	if (!Writer) return;
+
+	bEnabled.store(false, std::memory_order_release);
+
+	/* Kill waits for the writer to finish its final flush. */
+	WriterThread->Kill(true);
+	WriterThread.Reset();
+	Writer.Reset();
+}
+
+bool FWallRunTelemetry::IsEnabled()
+{
+	return WallRunTelemetry::bEnabled.load(std::memory_order_relaxed);
+}
+
+void FWallRunTelemetry::Record(const FWallRunTelemetryRecord& Record)
+{
+	using namespace WallRunTelemetry;
+
+	if (!IsEnabled()) return;
+
+	FThreadBuffer& ThreadBuffer = GetLocalThreadBuffer();
+
+	if (!ThreadBuffer.Queue.Enqueue(Record))
+	{
+		ThreadBuffer.NumDropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void FWallRunTelemetry::Flush()
+{
+	using namespace WallRunTelemetry;
+
+	if (Writer)
+	{
+		Writer->Flush();
+	}
+}
+
+uint64 FWallRunTelemetry::GetNumDroppedRecords()
+{
+	return WallRunTelemetry::TotalNumDropped.load(std::memory_order_relaxed);
+}
+
+FString FWallRunTelemetry::GetDefaultDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"));
+}
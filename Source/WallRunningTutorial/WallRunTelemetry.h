@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Wall run state transitions recorded by the telemetry sink. */
+enum class EWallRunTelemetryEvent : uint8
+{
+	/** The character started wall running. Detail is the EWallRunSide. */
+	WallRunBegin,
+
+	/** The character stopped wall running. Value0 is the duration in seconds and Value1 is the distance travelled. */
+	WallRunEnd,
+
+	/** The character's wall run cooldown on a surface started. Value0 is the configured cooldown duration in seconds. */
+	CooldownBegin,
+
+	/** The character reached a corner. Detail is the ECornerType and Value0 is 1 if the character started turning around it, or 0 if it fell off instead. */
+	CornerTurnBegin,
+
+	/** The character completed turning around a corner. Detail is the ECornerType. */
+	CornerTurnEnd,
+
+	/** The character's wall run cooldown on a surface ended. Location is where the cooldown began, and Value0 is how long the surface was on cooldown in seconds, including restarts while it was cooling down. */
+	CooldownEnd,
+};
+
+/** Fixed-size binary telemetry record. Written to disk as-is, so its layout must only change together with WallRunTelemetryVersion. */
+struct FWallRunTelemetryRecord
+{
+	/** World time that the event happened at. */
+	float WorldTimeSeconds = 0.0f;
+
+	/** Identifies the character that the event happened to. Only unique within a session. */
+	uint32 CharacterId = 0;
+
+	/** World location of the character when the event happened. */
+	FVector3f Location{};
+
+	/** Event specific values, see EWallRunTelemetryEvent. */
+	float Value0 = 0.0f;
+	float Value1 = 0.0f;
+
+	EWallRunTelemetryEvent Event{};
+
+	/** Event specific detail, see EWallRunTelemetryEvent. */
+	uint8 Detail = 0;
+
+	uint8 Padding[2]{};
+};
+
+static_assert(sizeof(FWallRunTelemetryRecord) == 32, "FWallRunTelemetryRecord is written to disk and must stay 32 bytes.");
+
+/** Header at the start of every telemetry file. */
+struct FWallRunTelemetryFileHeader
+{
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	uint16 RecordSize = 0;
+};
+
+static constexpr uint32 WallRunTelemetryMagic = 0x4C545257; // "WRTL"
+static constexpr uint16 WallRunTelemetryVersion = 1;
+
+/**
+ * FWallRunTelemetry is a low-overhead sink for wall run telemetry records.
+ * Each producing thread writes into its own preallocated lock-free ring buffer, and a background thread drains the buffers into rolling local files.
+ * Records are dropped rather than blocking the producer when a buffer is full.
+ */
+class WALLRUNNINGTUTORIAL_API FWallRunTelemetry
+{
+public:
+
+	/** Number of records each thread can buffer between flushes. Must be a power of two, and one slot is always left free. */
+	static constexpr uint32 ThreadBufferCapacity = 4096;
+
+	/**
+	 * Start the background writer.
+	 *
+	 * @param Directory:			Directory that the telemetry files are written to.
+	 * @param MaxFileSizeBytes:		Size at which the writer rolls over to a new file.
+	 * @param MaxFiles:				Number of files kept per session. The oldest file is deleted when a new one would exceed this.
+	 */
+	static void Start(const FString& Directory, const int64 MaxFileSizeBytes, const int32 MaxFiles);
+
+	/** Stop the background writer after flushing every buffered record. */
+	static void Stop();
+
+	/** Returns true if records are currently being collected. */
+	static bool IsEnabled();
+
+	/** Queue a record from the calling thread. Never allocates after the thread's first record, and never takes a lock. */
+	static void Record(const FWallRunTelemetryRecord& Record);
+
+	/** Drain every thread buffer to disk now, without waiting for the background writer. Does nothing if the writer isn't running. */
+	static void Flush();
+
+	/** Returns the number of records dropped because a thread buffer was full, as of the last flush. */
+	static uint64 GetNumDroppedRecords();
+
+	/** Returns the default directory for telemetry files. */
+	static FString GetDefaultDirectory();
+};
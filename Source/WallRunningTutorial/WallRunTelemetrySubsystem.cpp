@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WallRunTelemetrySubsystem.h"
+#include <Misc/CommandLine.h>
+#include "WallRunTelemetry.h"
+
+bool UWallRunTelemetrySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("WallRunTelemetry"));
+}
+
+void UWallRunTelemetrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FString Directory = FWallRunTelemetry::GetDefaultDirectory();
+	FParse::Value(FCommandLine::Get(), TEXT("WallRunTelemetryDir="), Directory);
+
+	FWallRunTelemetry::Start(Directory, static_cast<int64>(MaxFileSizeMB) * 1024 * 1024, MaxFiles);
+}
+
+void UWallRunTelemetrySubsystem::Deinitialize()
+{
+	FWallRunTelemetry::Stop();
+
+	Super::Deinitialize();
+}
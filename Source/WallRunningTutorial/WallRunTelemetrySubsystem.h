@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "WallRunTelemetrySubsystem.generated.h"
+
+/**
+ * UWallRunTelemetrySubsystem runs the FWallRunTelemetry writer for the lifetime of the game instance.
+ * Only created when the game is launched with -WallRunTelemetry. Files go to Saved/Telemetry unless -WallRunTelemetryDir= is given.
+ */
+UCLASS(config = Game)
+class WALLRUNNINGTUTORIAL_API UWallRunTelemetrySubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+private:
+
+	/** Size in megabytes at which the writer rolls over to a new file. */
+	UPROPERTY(Config)
+	int32 MaxFileSizeMB = 16;
+
+	/** Number of files kept per session. */
+	UPROPERTY(Config)
+	int32 MaxFiles = 8;
+};
@@ -9,8 +9,10 @@
 #include "GameFramework/Controller.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
+#include "InputMappingContext.h"
 #include "InputActionValue.h"
 #include "CustomCharacterMovementComponent.h"
+#include "Engine/AssetManager.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
@@ -20,6 +22,10 @@ DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 AWallRunningTutorialCharacter::AWallRunningTutorialCharacter(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer.SetDefaultSubobjectClass<UCustomCharacterMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
+	// Only tick while a camera lock-on is active, see SetCameraLockOnActive
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(42.f, 96.0f);
 		
@@ -64,6 +70,9 @@ void AWallRunningTutorialCharacter::PostInitializeComponents()
 	{
 		CustomCharacterMovementComponent->OnCornerTurnBegin.BindUObject(this, &AWallRunningTutorialCharacter::OnCornerTurnBegin);
 		CustomCharacterMovementComponent->OnCornerTurnEnd.BindUObject(this, &AWallRunningTutorialCharacter::OnCornerTurnEnd);
+		CustomCharacterMovementComponent->OnWallRunBegin.BindUObject(this, &AWallRunningTutorialCharacter::OnWallRunBegin);
+		CustomCharacterMovementComponent->OnWallRunEnd.BindUObject(this, &AWallRunningTutorialCharacter::OnWallRunEnd);
+		CustomCharacterMovementComponent->OnWallRunWallNormalChanged.BindUObject(this, &AWallRunningTutorialCharacter::OnWallRunWallNormalChanged);
 	}
 }
 
@@ -89,47 +98,124 @@ void AWallRunningTutorialCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	bCameraLockOnActive = false;
+	SetCameraLockOnActive(false);
+
+	DefaultCameraTargetOffset = CameraBoom->TargetOffset;
+	DefaultCameraProbeSize = CameraBoom->ProbeSize;
 }
 
 void AWallRunningTutorialCharacter::NotifyControllerChanged()
 {
 	Super::NotifyControllerChanged();
 
-	// Add Input Mapping Context
-	if (APlayerController* PlayerController = Cast<APlayerController>(Controller))
+	// The mapping context is added once the input assets have streamed in
+	StreamInputAssets();
+}
+
+void AWallRunningTutorialCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
+{
+	// Set up action bindings once the input actions have streamed in
+	if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerInputComponent)) {
+
+		InputComponentToBind = EnhancedInputComponent;
+		StreamInputAssets();
+	}
+	else
 	{
-		if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))
+		UE_LOG(LogTemplateCharacter, Error, TEXT("'%s' Failed to find an Enhanced Input component! This template is built to use the Enhanced Input system. If you intend to use the legacy system, then you will need to update this C++ file."), *GetNameSafe(this));
+	}
+}
+
+void AWallRunningTutorialCharacter::StreamInputAssets()
+{
+	// Both the controller and the input component need the input assets, but they are only requested once. An outstanding request calls back for both.
+	if (InputAssetsHandle.IsValid())
+	{
+		if (!InputAssetsHandle->IsLoadingInProgress())
+		{
+			OnInputAssetsLoaded();
+		}
+
+		return;
+	}
+
+	// Input assets are normally already resident once the wall run asset set's client bundle has streamed in
+	TArray<FSoftObjectPath> AssetsToLoad;
+
+	for (const FSoftObjectPath& AssetPath : { DefaultMappingContext.ToSoftObjectPath(), JumpAction.ToSoftObjectPath(), MoveAction.ToSoftObjectPath(), LookAction.ToSoftObjectPath(), WallRunAction.ToSoftObjectPath() })
+	{
+		if (!AssetPath.IsNull() && !AssetPath.ResolveObject())
 		{
-			Subsystem->AddMappingContext(DefaultMappingContext, 0);
+			AssetsToLoad.Add(AssetPath);
 		}
 	}
+
+	if (AssetsToLoad.IsEmpty())
+	{
+		OnInputAssetsLoaded();
+		return;
+	}
+
+	InputAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad, FStreamableDelegate::CreateUObject(this, &AWallRunningTutorialCharacter::OnInputAssetsLoaded));
 }
 
-void AWallRunningTutorialCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
+void AWallRunningTutorialCharacter::OnInputAssetsLoaded()
 {
-	// Set up action bindings
-	if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerInputComponent)) {
-		
-		// Jumping
-		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Started, this, &ACharacter::Jump);
-		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Completed, this, &ACharacter::StopJumping);
-
-		// Moving
-		EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Triggered, this, &AWallRunningTutorialCharacter::Move);
+	// Input assets that failed to load are skipped, so only the input they drive is missing
+	auto GetLoadedInputAsset = [this](const auto& InputAsset)
+	{
+		if (!InputAsset.IsNull() && !InputAsset.Get())
+		{
+			UE_LOG(LogTemplateCharacter, Error, TEXT("'%s' Failed to load input asset '%s'."), *GetNameSafe(this), *InputAsset.ToString());
+		}
 
-		// Looking
-		EnhancedInputComponent->BindAction(LookAction, ETriggerEvent::Triggered, this, &AWallRunningTutorialCharacter::Look);
+		return InputAsset.Get();
+	};
 
-		if (UCustomCharacterMovementComponent* CustomCharacterMovementComponent = GetCustomCharacterMovement())
+	// Add Input Mapping Context
+	if (APlayerController* PlayerController = Cast<APlayerController>(Controller))
+	{
+		if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))
 		{
-			EnhancedInputComponent->BindAction(WallRunAction, ETriggerEvent::Started, CustomCharacterMovementComponent, &UCustomCharacterMovementComponent::WallRunStart);
-			EnhancedInputComponent->BindAction(WallRunAction, ETriggerEvent::Completed, CustomCharacterMovementComponent, &UCustomCharacterMovementComponent::WallRunStop);
+			if (const UInputMappingContext* const MappingContext = GetLoadedInputAsset(DefaultMappingContext))
+			{
+				Subsystem->AddMappingContext(MappingContext, 0);
+			}
 		}
 	}
-	else
+
+	UEnhancedInputComponent* const EnhancedInputComponent = InputComponentToBind.Get();
+
+	if (!EnhancedInputComponent) return;
+
+	InputComponentToBind.Reset();
+
+	// Jumping
+	if (const UInputAction* const JumpInputAction = GetLoadedInputAsset(JumpAction))
 	{
-		UE_LOG(LogTemplateCharacter, Error, TEXT("'%s' Failed to find an Enhanced Input component! This template is built to use the Enhanced Input system. If you intend to use the legacy system, then you will need to update this C++ file."), *GetNameSafe(this));
+		EnhancedInputComponent->BindAction(JumpInputAction, ETriggerEvent::Started, this, &ACharacter::Jump);
+		EnhancedInputComponent->BindAction(JumpInputAction, ETriggerEvent::Completed, this, &ACharacter::StopJumping);
+	}
+
+	// Moving
+	if (const UInputAction* const MoveInputAction = GetLoadedInputAsset(MoveAction))
+	{
+		EnhancedInputComponent->BindAction(MoveInputAction, ETriggerEvent::Triggered, this, &AWallRunningTutorialCharacter::Move);
+	}
+
+	// Looking
+	if (const UInputAction* const LookInputAction = GetLoadedInputAsset(LookAction))
+	{
+		EnhancedInputComponent->BindAction(LookInputAction, ETriggerEvent::Triggered, this, &AWallRunningTutorialCharacter::Look);
+	}
+
+	UCustomCharacterMovementComponent* const CustomCharacterMovementComponent = GetCustomCharacterMovement();
+	const UInputAction* const WallRunInputAction = GetLoadedInputAsset(WallRunAction);
+
+	if (CustomCharacterMovementComponent && WallRunInputAction)
+	{
+		EnhancedInputComponent->BindAction(WallRunInputAction, ETriggerEvent::Started, CustomCharacterMovementComponent, &UCustomCharacterMovementComponent::WallRunStart);
+		EnhancedInputComponent->BindAction(WallRunInputAction, ETriggerEvent::Completed, CustomCharacterMovementComponent, &UCustomCharacterMovementComponent::WallRunStop);
 	}
 }
 
@@ -154,14 +240,23 @@ void AWallRunningTutorialCharacter::OnCornerTurnBegin(const FVector& CornerTurnD
 			TargetCameraRotation.Yaw += TargetCameraRotationYawOffset;
 		}
 		
-		bCameraLockOnActive = true;
+		SetCameraLockOnActive(true);
 	}
 }
 
 void AWallRunningTutorialCharacter::OnCornerTurnEnd()
 {
 	/** Turn off the camera lockon mechanic when the character is no longer turning around a corner. */
-	bCameraLockOnActive = false;
+	SetCameraLockOnActive(false);
+
+	/** The character is now running along a different wall, so offset the camera from that wall instead. */
+	if (const UCustomCharacterMovementComponent* const CustomCharacterMovementComponent = GetCustomCharacterMovement())
+	{
+		if (CustomCharacterMovementComponent->IsWallRunning())
+		{
+			ApplyWallRunCameraMode(CustomCharacterMovementComponent->GetWallRunWallNormal());
+		}
+	}
 }
 
 void AWallRunningTutorialCharacter::RotateCameraToTarget(float DeltaTime)
@@ -170,6 +265,46 @@ void AWallRunningTutorialCharacter::RotateCameraToTarget(float DeltaTime)
 	GetController()->SetControlRotation(InterpedTargetRotation);
 }
 
+void AWallRunningTutorialCharacter::OnWallRunBegin(const FVector& WallNormal)
+{
+	ApplyWallRunCameraMode(WallNormal);
+}
+
+void AWallRunningTutorialCharacter::OnWallRunEnd()
+{
+	ResetWallRunCameraMode();
+	SetCameraLockOnActive(false);
+}
+
+void AWallRunningTutorialCharacter::OnWallRunWallNormalChanged(const FVector& WallNormal)
+{
+	// Keep the camera offset from the wall as the character follows a curved wall
+	ApplyWallRunCameraMode(WallNormal);
+}
+
+void AWallRunningTutorialCharacter::ApplyWallRunCameraMode(const FVector& WallNormal)
+{
+	// The camera is already pushed away from the wall, so the boom's collision test only needs a narrow probe to catch everything else
+	CameraBoom->TargetOffset = DefaultCameraTargetOffset + WallNormal.GetSafeNormal2D() * WallRunCameraWallOffset;
+
+	if (WallRunCameraProbeSize > 0.0f)
+	{
+		CameraBoom->ProbeSize = WallRunCameraProbeSize;
+	}
+}
+
+void AWallRunningTutorialCharacter::ResetWallRunCameraMode()
+{
+	CameraBoom->TargetOffset = DefaultCameraTargetOffset;
+	CameraBoom->ProbeSize = DefaultCameraProbeSize;
+}
+
+void AWallRunningTutorialCharacter::SetCameraLockOnActive(bool bActive)
+{
+	bCameraLockOnActive = bActive;
+	SetActorTickEnabled(bActive);
+}
+
 void AWallRunningTutorialCharacter::Move(const FInputActionValue& Value)
 {
 	// input is a Vector2D
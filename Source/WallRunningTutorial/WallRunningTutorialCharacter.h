@@ -11,7 +11,9 @@ class USpringArmComponent;
 class UCameraComponent;
 class UInputMappingContext;
 class UInputAction;
+class UEnhancedInputComponent;
 struct FInputActionValue;
+struct FStreamableHandle;
 enum ECornerType : uint8;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
@@ -32,24 +34,30 @@ class AWallRunningTutorialCharacter : public ACharacter
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* FollowCamera;
 	
-	/** MappingContext */
+	/** MappingContext. Input assets are soft references that are streamed in with the wall run asset set's client bundle. */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
-	UInputMappingContext* DefaultMappingContext;
+	TSoftObjectPtr<UInputMappingContext> DefaultMappingContext;
 
 	/** Jump Input Action */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
-	UInputAction* JumpAction;
+	TSoftObjectPtr<UInputAction> JumpAction;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
-	UInputAction* WallRunAction;
+	TSoftObjectPtr<UInputAction> WallRunAction;
 
 	/** Move Input Action */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
-	UInputAction* MoveAction;
+	TSoftObjectPtr<UInputAction> MoveAction;
 
 	/** Look Input Action */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
-	UInputAction* LookAction;
+	TSoftObjectPtr<UInputAction> LookAction;
+
+	/** Handle keeping the input assets loaded while they are streamed in. */
+	TSharedPtr<FStreamableHandle> InputAssetsHandle;
+
+	/** Input component to bind the input actions to once they have streamed in. */
+	TWeakObjectPtr<UEnhancedInputComponent> InputComponentToBind{ nullptr };
 
 	/** Interpolation speed for rotating the CameraBoom to the target rotation for camera lock-ons. */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
@@ -58,6 +66,18 @@ class AWallRunningTutorialCharacter : public ACharacter
 	/** True if the camera should lock onto a target. */
 	bool bCameraLockOnActive = false;
 
+	/** Distance to push the end of the CameraBoom away from the wall while wall running, so the camera doesn't need to collide with the wall to stay clear of it. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	float WallRunCameraWallOffset = 60.0f;
+
+	/** Probe size of the CameraBoom's collision test while wall running. Narrower than the default probe, as the wall offset already keeps the camera clear of the wall. If zero, the default probe size is kept. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float WallRunCameraProbeSize = 6.0f;
+
+	/** CameraBoom settings to restore once the wall run camera mode ends. */
+	FVector DefaultCameraTargetOffset{};
+	float DefaultCameraProbeSize = 0.0f;
+
 public:
 
 	AWallRunningTutorialCharacter(const FObjectInitializer& ObjectInitializer);	
@@ -85,6 +105,12 @@ protected:
 
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
+	/** Streams in the input assets that aren't loaded yet, calling OnInputAssetsLoaded once they all are. The assets are only requested once. */
+	void StreamInputAssets();
+
+	/** Adds the mapping context and binds the input actions once the input assets are loaded. Assets that failed to load are skipped. */
+	virtual void OnInputAssetsLoaded();
+
 	/** Called when the character is beginning to turn around a corner for wall running. */
 	virtual void OnCornerTurnBegin(const FVector& CornerTurnDirection, const ECornerType CornerType);
 
@@ -94,6 +120,24 @@ protected:
 	/** Rotates the CameraBoom when the character's camera should lock onto a target. */
 	virtual void RotateCameraToTarget(float DeltaTime);
 
+	/** Called when the character has started wall running. */
+	virtual void OnWallRunBegin(const FVector& WallNormal);
+
+	/** Called when the character has stopped wall running. */
+	virtual void OnWallRunEnd();
+
+	/** Called when the normal of the wall that the character is running on has noticeably changed, such as along a curved wall. */
+	virtual void OnWallRunWallNormalChanged(const FVector& WallNormal);
+
+	/** Offsets the CameraBoom away from the wall and narrows its collision test, using the wall plane found by the movement component. */
+	virtual void ApplyWallRunCameraMode(const FVector& WallNormal);
+
+	/** Restores the CameraBoom settings from before the wall run camera mode. */
+	virtual void ResetWallRunCameraMode();
+
+	/** Turns the camera lock-on on or off. The character only ticks while the lock-on is active. */
+	void SetCameraLockOnActive(bool bActive);
+
 public:
 	/** Returns CameraBoom subobject **/
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
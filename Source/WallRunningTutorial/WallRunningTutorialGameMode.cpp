@@ -2,14 +2,62 @@
 
 #include "WallRunningTutorialGameMode.h"
 #include "WallRunningTutorialCharacter.h"
-#include "UObject/ConstructorHelpers.h"
+#include "WallRunAssetSet.h"
+#include "WallRunAssetSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
+#include "GameFramework/DefaultPawn.h"
 
-AWallRunningTutorialGameMode::AWallRunningTutorialGameMode()
+void AWallRunningTutorialGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
 {
-	// set default pawn class to our Blueprinted character
-	static ConstructorHelpers::FClassFinder<APawn> PlayerPawnBPClass(TEXT("/Game/ThirdPerson/Blueprints/BP_ThirdPersonCharacter"));
-	if (PlayerPawnBPClass.Class != NULL)
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	// Only replace the engine default, a pawn class picked by a Blueprint subclass always wins
+	bUseStreamedPawnClass = !DefaultPawnClass || DefaultPawnClass == ADefaultPawn::StaticClass();
+
+	if (!bUseStreamedPawnClass) return;
+
+	// The pawn class is part of the asset set's game bundle, which started streaming in when the game instance started
+	if (UWallRunAssetSubsystem* const AssetSubsystem = UGameInstance::GetSubsystem<UWallRunAssetSubsystem>(GetGameInstance()))
+	{
+		AssetSubsystem->CallOrRegister_OnAssetsLoaded(FSimpleMulticastDelegate::FDelegate::CreateUObject(this, &AWallRunningTutorialGameMode::OnWallRunAssetsLoaded));
+	}
+}
+
+UClass* AWallRunningTutorialGameMode::GetDefaultPawnClassForController_Implementation(AController* InController)
+{
+	if (bUseStreamedPawnClass)
+	{
+		WaitForWallRunAssets();
+	}
+
+	return Super::GetDefaultPawnClassForController_Implementation(InController);
+}
+
+void AWallRunningTutorialGameMode::OnWallRunAssetsLoaded()
+{
+	const UWallRunAssetSubsystem* const AssetSubsystem = UGameInstance::GetSubsystem<UWallRunAssetSubsystem>(GetGameInstance());
+	const UWallRunAssetSet* const AssetSet = AssetSubsystem ? AssetSubsystem->GetAssetSet() : nullptr;
+
+	if (UClass* const PawnClass = AssetSet ? AssetSet->PawnClass.Get() : nullptr)
 	{
-		DefaultPawnClass = PlayerPawnBPClass.Class;
+		DefaultPawnClass = PawnClass;
 	}
 }
+
+void AWallRunningTutorialGameMode::WaitForWallRunAssets()
+{
+	const UWallRunAssetSubsystem* const AssetSubsystem = UGameInstance::GetSubsystem<UWallRunAssetSubsystem>(GetGameInstance());
+	const TSharedPtr<FStreamableHandle> AssetSetHandle = AssetSubsystem ? AssetSubsystem->GetLoadHandle() : nullptr;
+
+	if (!AssetSetHandle.IsValid() || !AssetSetHandle->IsLoadingInProgress()) return;
+
+	// Usually only happens when the first map loads faster than the assets stream in, such as in PIE
+	const double WaitStartTime = FPlatformTime::Seconds();
+	AssetSetHandle->WaitUntilComplete();
+
+	UE_LOG(LogGameMode, Log, TEXT("%s: A pawn was requested before the wall run assets finished streaming in. Waited %.1f ms for them."), *GetNameSafe(this), (FPlatformTime::Seconds() - WaitStartTime) * 1000.0);
+
+	// The completion delegate may only be called on a later frame, but the pawn class is needed now
+	OnWallRunAssetsLoaded();
+}
@@ -6,14 +6,24 @@
 #include "GameFramework/GameModeBase.h"
 #include "WallRunningTutorialGameMode.generated.h"
 
-UCLASS(minimalapi)
+UCLASS(minimalapi, config=Game)
 class AWallRunningTutorialGameMode : public AGameModeBase
 {
 	GENERATED_BODY()
 
+	/** True if nothing else picked a default pawn class, so the pawn class of the wall run asset set should be used. */
+	bool bUseStreamedPawnClass = false;
+
 public:
-	AWallRunningTutorialGameMode();
-};
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
 
+	virtual UClass* GetDefaultPawnClassForController_Implementation(AController* InController) override;
 
+protected:
 
+	/** Called once the wall run assets, including the pawn class, have streamed in. */
+	virtual void OnWallRunAssetsLoaded();
+
+	/** Blocks on the outstanding wall run asset stream if a player needs a pawn before it has finished. */
+	void WaitForWallRunAssets();
+};
@@ -0,0 +1,326 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WallrunnableRegistrySubsystem.h"
+#include <Components/PrimitiveComponent.h>
+#include <Engine/Level.h>
+#include <Engine/World.h>
+#include <GameFramework/Actor.h>
+#include "WallRunCollisionChannels.h"
+#include "WallrunnableInterface.h"
+
+void UWallrunnableRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UWallrunnableRegistrySubsystem::OnActorSpawned));
+	LevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UWallrunnableRegistrySubsystem::OnLevelAddedToWorld);
+}
+
+void UWallrunnableRegistrySubsystem::Deinitialize()
+{
+	GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedToWorldHandle);
+
+	for (FWallrunnableSurface& Entry : Surfaces)
+	{
+		if (UPrimitiveComponent* const Surface = Entry.Surface.Get())
+		{
+			Surface->TransformUpdated.Remove(Entry.TransformUpdatedHandle);
+		}
+	}
+
+	Surfaces.Empty();
+	SurfaceIndices.Empty();
+	Cells.Empty();
+	OversizedSurfaces.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWallrunnableRegistrySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (const ULevel* const Level : InWorld.GetLevels())
+	{
+		RegisterLevelActors(Level);
+	}
+}
+
+void UWallrunnableRegistrySubsystem::RegisterActor(AActor* Actor)
+{
+	if (!Actor) return;
+
+	/* Only components that block the wall run channel can be wall run on. Components that no longer do are removed, so this also refreshes the actor. */
+	Actor->ForEachComponent<UPrimitiveComponent>(false, [this](UPrimitiveComponent* Component)
+	{
+		if (Component->IsQueryCollisionEnabled() && Component->GetCollisionResponseToChannel(ECC_WallRun) == ECR_Block)
+		{
+			RegisterSurface(Component);
+		}
+		else
+		{
+			UnregisterSurface(Component);
+		}
+	});
+}
+
+void UWallrunnableRegistrySubsystem::UnregisterActor(AActor* Actor)
+{
+	if (!Actor) return;
+
+	Actor->ForEachComponent<UPrimitiveComponent>(false, [this](UPrimitiveComponent* Component)
+	{
+		UnregisterSurface(Component);
+	});
+}
+
+bool UWallrunnableRegistrySubsystem::IsRegistered(const UPrimitiveComponent* Surface) const
+{
+	return Surface && SurfaceIndices.Contains(Surface);
+}
+
+void UWallrunnableRegistrySubsystem::QueryNearby(const FVector& Location, const float Radius, TArray<UPrimitiveComponent*>& OutSurfaces) const
+{
+	ForEachSurfaceInSphere(Location, Radius, [&OutSurfaces](const FWallrunnableSurface& Entry)
+	{
+		OutSurfaces.Add(Entry.Surface.Get());
+		return true;
+	});
+}
+
+bool UWallrunnableRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWallrunnableRegistrySubsystem::OnSurfaceTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	if (const int32* const SurfaceIndex = SurfaceIndices.Find(Cast<UPrimitiveComponent>(UpdatedComponent)))
+	{
+		UpdateSurfaceBounds(*SurfaceIndex);
+	}
+}
+
+void UWallrunnableRegistrySubsystem::OnActorSpawned(AActor* Actor)
+{
+	/* Actors spawned while the world is loading are picked up when it begins play. */
+	if (!GetWorld()->HasBegunPlay()) return;
+
+	RegisterWallrunnableActor(Actor);
+}
+
+void UWallrunnableRegistrySubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld() || !World->HasBegunPlay()) return;
+
+	RegisterLevelActors(Level);
+}
+
+void UWallrunnableRegistrySubsystem::OnActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterActor(Actor);
+}
+
+void UWallrunnableRegistrySubsystem::RegisterWallrunnableActor(AActor* Actor)
+{
+	if (!Actor || !Actor->Implements<UWallrunnableInterface>()) return;
+
+	RegisterActor(Actor);
+	Actor->OnEndPlay.AddUniqueDynamic(this, &UWallrunnableRegistrySubsystem::OnActorEndPlay);
+}
+
+void UWallrunnableRegistrySubsystem::RegisterLevelActors(const ULevel* Level)
+{
+	if (!Level) return;
+
+	for (AActor* const Actor : Level->Actors)
+	{
+		RegisterWallrunnableActor(Actor);
+	}
+}
+
+void UWallrunnableRegistrySubsystem::RegisterSurface(UPrimitiveComponent* Surface)
+{
+	if (const int32* const SurfaceIndex = SurfaceIndices.Find(Surface))
+	{
+		UpdateSurfaceBounds(*SurfaceIndex);
+		return;
+	}
+
+	FWallrunnableSurface Entry{};
+	Entry.Surface = Surface;
+	Entry.TransformUpdatedHandle = Surface->TransformUpdated.AddUObject(this, &UWallrunnableRegistrySubsystem::OnSurfaceTransformUpdated);
+
+	const int32 SurfaceIndex = Surfaces.Add(MoveTemp(Entry));
+	SurfaceIndices.Add(Surface, SurfaceIndex);
+
+	UpdateSurfaceBounds(SurfaceIndex);
+}
+
+void UWallrunnableRegistrySubsystem::UnregisterSurface(UPrimitiveComponent* Surface)
+{
+	int32 SurfaceIndex = INDEX_NONE;
+
+	if (!SurfaceIndices.RemoveAndCopyValue(Surface, SurfaceIndex)) return;
+
+	Surface->TransformUpdated.Remove(Surfaces[SurfaceIndex].TransformUpdatedHandle);
+
+	RemoveFromCells(SurfaceIndex);
+	Surfaces.RemoveAt(SurfaceIndex);
+}
+
+void UWallrunnableRegistrySubsystem::UpdateSurfaceBounds(const int32 SurfaceIndex)
+{
+	FWallrunnableSurface& Entry = Surfaces[SurfaceIndex];
+	const UPrimitiveComponent* const Surface = Entry.Surface.Get();
+
+	if (!Surface) return;
+
+	Entry.Bounds = Surface->Bounds.GetBox();
+
+	/* Most movements stay within the loose bounds and only need the exact bounds updated. */
+	if (Entry.LooseBounds.IsValid && Entry.LooseBounds.IsInside(Entry.Bounds)) return;
+
+	const bool bWasBucketed = Entry.LooseBounds.IsValid != 0;
+	const FBox NewLooseBounds = Entry.Bounds.ExpandBy(LooseMargin);
+
+	const FIntVector NewMinCell = GetCell(NewLooseBounds.Min);
+	const FIntVector NewMaxCell = GetCell(NewLooseBounds.Max);
+	const FIntVector NumCells = NewMaxCell - NewMinCell + FIntVector(1);
+	const bool bOversized = (int64)NumCells.X * NumCells.Y * NumCells.Z > MaxCellsPerSurface;
+
+	const bool bCellsChanged = !bWasBucketed || bOversized != Entry.bOversized || (!bOversized && (NewMinCell != Entry.MinCell || NewMaxCell != Entry.MaxCell));
+
+	if (bCellsChanged && bWasBucketed)
+	{
+		RemoveFromCells(SurfaceIndex);
+	}
+
+	Entry.LooseBounds = NewLooseBounds;
+	Entry.MinCell = NewMinCell;
+	Entry.MaxCell = NewMaxCell;
+	Entry.bOversized = bOversized;
+
+	if (bCellsChanged)
+	{
+		AddToCells(SurfaceIndex);
+	}
+}
+
+void UWallrunnableRegistrySubsystem::AddToCells(const int32 SurfaceIndex)
+{
+	const FWallrunnableSurface& Entry = Surfaces[SurfaceIndex];
+
+	if (Entry.bOversized)
+	{
+		OversizedSurfaces.Add(SurfaceIndex);
+		return;
+	}
+
+	for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+	{
+		for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+		{
+			for (int32 Z = Entry.MinCell.Z; Z <= Entry.MaxCell.Z; ++Z)
+			{
+				Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(SurfaceIndex);
+			}
+		}
+	}
+}
+
+void UWallrunnableRegistrySubsystem::RemoveFromCells(const int32 SurfaceIndex)
+{
+	const FWallrunnableSurface& Entry = Surfaces[SurfaceIndex];
+
+	if (!Entry.LooseBounds.IsValid) return;
+
+	if (Entry.bOversized)
+	{
+		OversizedSurfaces.RemoveSwap(SurfaceIndex, EAllowShrinking::No);
+		return;
+	}
+
+	for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+	{
+		for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+		{
+			for (int32 Z = Entry.MinCell.Z; Z <= Entry.MaxCell.Z; ++Z)
+			{
+				const FIntVector Cell(X, Y, Z);
+
+				if (TArray<int32, TInlineAllocator<4>>* const CellSurfaces = Cells.Find(Cell))
+				{
+					CellSurfaces->RemoveSwap(SurfaceIndex, EAllowShrinking::No);
+
+					/* Drop empty cells so that surfaces travelling across the level don't leave a trail of them behind. */
+					if (CellSurfaces->IsEmpty())
+					{
+						Cells.Remove(Cell);
+					}
+				}
+			}
+		}
+	}
+}
+
+FIntVector UWallrunnableRegistrySubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize), FMath::FloorToInt32(Location.Z / CellSize));
+}
+
+void UWallrunnableRegistrySubsystem::ForEachSurfaceInSphere(const FVector& Location, const float Radius, TFunctionRef<bool(const FWallrunnableSurface&)> Visitor) const
+{
+	/* Stamps of zero mean "never visited", so reset every stamp when the counter wraps around. */
+	if (++QueryStamp == 0)
+	{
+		for (const FWallrunnableSurface& Entry : Surfaces)
+		{
+			Entry.QueryStamp = 0;
+		}
+
+		QueryStamp = 1;
+	}
+
+	const double RadiusSquared = FMath::Square(Radius);
+
+	auto VisitSurface = [this, &Location, RadiusSquared, &Visitor](const int32 SurfaceIndex)
+	{
+		const FWallrunnableSurface& Entry = Surfaces[SurfaceIndex];
+
+		if (Entry.QueryStamp == QueryStamp) return true;
+		Entry.QueryStamp = QueryStamp;
+
+		if (!Entry.Surface.IsValid() || !FMath::SphereAABBIntersection(Location, RadiusSquared, Entry.Bounds)) return true;
+
+		return Visitor(Entry);
+	};
+
+	for (const int32 SurfaceIndex : OversizedSurfaces)
+	{
+		if (!VisitSurface(SurfaceIndex)) return;
+	}
+
+	const FIntVector MinCell = GetCell(Location - FVector(Radius));
+	const FIntVector MaxCell = GetCell(Location + FVector(Radius));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const TArray<int32, TInlineAllocator<4>>* const CellSurfaces = Cells.Find(FIntVector(X, Y, Z));
+
+				if (!CellSurfaces) continue;
+
+				for (const int32 SurfaceIndex : *CellSurfaces)
+				{
+					if (!VisitSurface(SurfaceIndex)) return;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WallrunnableRegistrySubsystem.generated.h"
+
+/** A wallrunnable surface tracked by the registry. */
+struct FWallrunnableSurface
+{
+	/** The component that blocks the wall run trace channel. */
+	TWeakObjectPtr<UPrimitiveComponent> Surface;
+
+	/** World bounds of the surface as of its last transform update. */
+	FBox Bounds{ ForceInit };
+
+	/** Bounds that the surface is bucketed by. Larger than Bounds, so that small movements don't move the surface between cells. */
+	FBox LooseBounds{ ForceInit };
+
+	/** Range of grid cells that the surface is bucketed in. Unused if the surface is oversized. */
+	FIntVector MinCell{};
+	FIntVector MaxCell{};
+
+	/** Handle of the surface's transform updated binding. */
+	FDelegateHandle TransformUpdatedHandle;
+
+	/** Stamp of the last query that visited the surface. Prevents a surface spanning several cells from being reported more than once. */
+	mutable uint32 QueryStamp = 0;
+
+	/** If true, the surface spans too many cells to bucket and is checked by every query instead. */
+	bool bOversized = false;
+};
+
+/**
+ * UWallrunnableRegistrySubsystem keeps track of every wallrunnable surface in the world in a loose uniform grid, so characters can cheaply find the
+ * surfaces around them. Every actor implementing IWallrunnableInterface is registered when the world begins play, when it's spawned or when its level is
+ * streamed in, and unregistered when it ends play. Moving surfaces are only re-bucketed when they leave their loose bounds, so the grid is never rebuilt.
+ */
+UCLASS(config = Game)
+class WALLRUNNINGTUTORIAL_API UWallrunnableRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/**
+	 * Register every component of an actor that blocks the wall run trace channel. Registering an actor again refreshes its components.
+	 *
+	 * @param Actor:		The wallrunnable actor.
+	 */
+	UFUNCTION(BlueprintCallable, Category = WallRun)
+	void RegisterActor(AActor* Actor);
+
+	/**
+	 * Unregister every component of an actor.
+	 *
+	 * @param Actor:		The wallrunnable actor.
+	 */
+	UFUNCTION(BlueprintCallable, Category = WallRun)
+	void UnregisterActor(AActor* Actor);
+
+	/** Returns true if the component is a registered wallrunnable surface. */
+	bool IsRegistered(const UPrimitiveComponent* Surface) const;
+
+	/**
+	 * Find the wallrunnable surfaces whose bounds are within a radius of a location.
+	 *
+	 * @param Location:			World location to search around.
+	 * @param Radius:			Search radius.
+	 * @param OutSurfaces:		[Out] The surfaces that were found.
+	 */
+	void QueryNearby(const FVector& Location, const float Radius, TArray<UPrimitiveComponent*>& OutSurfaces) const;
+
+	/** Returns the number of registered surfaces. */
+	FORCEINLINE int32 GetNumSurfaces() const { return Surfaces.Num(); }
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Moves a surface to the cells that its new bounds overlap if it has left its loose bounds. */
+	void OnSurfaceTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	/** Registers actors spawned after the world has begun play. */
+	void OnActorSpawned(AActor* Actor);
+
+	/** Registers the actors of levels streamed in after the world has begun play. */
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+
+	/** Unregisters actors that end play, including ones whose level is streamed out. */
+	UFUNCTION()
+	void OnActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+private:
+
+	/** Registers an actor if it implements IWallrunnableInterface, and unregisters it again once it ends play. */
+	void RegisterWallrunnableActor(AActor* Actor);
+
+	/** Registers every wallrunnable actor in a level. */
+	void RegisterLevelActors(const ULevel* Level);
+
+	void RegisterSurface(UPrimitiveComponent* Surface);
+	void UnregisterSurface(UPrimitiveComponent* Surface);
+
+	/** Updates the bounds of a surface, re-bucketing it if needed. */
+	void UpdateSurfaceBounds(const int32 SurfaceIndex);
+
+	void AddToCells(const int32 SurfaceIndex);
+	void RemoveFromCells(const int32 SurfaceIndex);
+
+	/** Returns the cell that contains a location. */
+	FIntVector GetCell(const FVector& Location) const;
+
+	/**
+	 * Visit every valid surface whose bounds intersect a sphere, once each.
+	 *
+	 * @param Visitor:		Called with each surface. Return false to stop visiting.
+	 */
+	void ForEachSurfaceInSphere(const FVector& Location, const float Radius, TFunctionRef<bool(const FWallrunnableSurface&)> Visitor) const;
+
+	/** Every registered surface. Indices stay stable while a surface is registered. */
+	TSparseArray<FWallrunnableSurface> Surfaces;
+
+	/** Index into Surfaces of each registered component. */
+	TMap<TObjectKey<UPrimitiveComponent>, int32> SurfaceIndices;
+
+	/** Indices of the surfaces overlapping each occupied cell. */
+	TMap<FIntVector, TArray<int32, TInlineAllocator<4>>> Cells;
+
+	/** Indices of surfaces that span more than MaxCellsPerSurface cells. */
+	TArray<int32> OversizedSurfaces;
+
+	/** Incremented by every query. */
+	mutable uint32 QueryStamp = 0;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle LevelAddedToWorldHandle;
+
+	/** Edge length of a grid cell. */
+	UPROPERTY(Config)
+	float CellSize = 1000.0f;
+
+	/** Distance that a surface's bounds may move before it's re-bucketed. */
+	UPROPERTY(Config)
+	float LooseMargin = 200.0f;
+
+	/** Surfaces spanning more cells than this are checked by every query instead of being bucketed. */
+	UPROPERTY(Config)
+	int32 MaxCellsPerSurface = 64;
+};
@@ -2,4 +2,136 @@
 
 
 #include "WallrunnableStaticMeshActor.h"
+#include <Components/BoxComponent.h>
+#include <Components/StaticMeshComponent.h>
+#include <Engine/StaticMesh.h>
+#include <PhysicsEngine/BodySetup.h>
+#include "WallRunCollisionChannels.h"
+#include "WallrunnableRegistrySubsystem.h"
 
+AWallrunnableStaticMeshActor::AWallrunnableStaticMeshActor()
+{
+	WallRunProxy = CreateDefaultSubobject<UBoxComponent>(TEXT("WallRunProxy"));
+	WallRunProxy->SetupAttachment(GetStaticMeshComponent());
+	WallRunProxy->SetMobility(GetStaticMeshComponent()->Mobility);
+	WallRunProxy->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	WallRunProxy->SetCollisionResponseToAllChannels(ECR_Ignore);
+	WallRunProxy->SetCollisionResponseToChannel(ECC_WallRun, ECR_Block);
+	WallRunProxy->SetGenerateOverlapEvents(false);
+	WallRunProxy->SetCanEverAffectNavigation(false);
+	WallRunProxy->CanCharacterStepUpOn = ECB_No;
+}
+
+void AWallrunnableStaticMeshActor::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	UpdateWallRunProxy();
+}
+
+void AWallrunnableStaticMeshActor::BeginPlay()
+{
+	/* Construction scripts don't rerun for loaded level actors in game, so refit a stale proxy before anything queries it. */
+	if (IsWallRunProxyOutOfDate())
+	{
+		UpdateWallRunProxy();
+	}
+
+	Super::BeginPlay();
+
+	/* The registry picked this actor up when it spawned, but the proxy may have been refit since. */
+	if (UWallrunnableRegistrySubsystem* const Registry = GetWorld()->GetSubsystem<UWallrunnableRegistrySubsystem>())
+	{
+		Registry->RegisterActor(this);
+	}
+}
+
+bool AWallrunnableStaticMeshActor::UsesComplexWallRunCollision() const
+{
+	if (GetWallRunProxyBox()) return false;
+
+	const UStaticMesh* const StaticMesh = GetStaticMeshComponent()->GetStaticMesh();
+	const UBodySetup* const BodySetup = StaticMesh ? StaticMesh->GetBodySetup() : nullptr;
+
+	if (!BodySetup) return false;
+
+	return BodySetup->GetCollisionTraceFlag() == CTF_UseComplexAsSimple || BodySetup->AggGeom.GetElementCount() == 0;
+}
+
+bool AWallrunnableStaticMeshActor::IsWallRunProxyOutOfDate() const
+{
+	/* Generated shapes are compared with a small tolerance, as they are serialized with the level. */
+	static constexpr double Tolerance = 0.1;
+
+	const UStaticMeshComponent* const MeshComponent = GetStaticMeshComponent();
+
+	/* A static proxy under a static mesh keeps hitting queries that only look at static geometry. */
+	if (WallRunProxy->Mobility != MeshComponent->Mobility) return true;
+
+	const FKBoxElem* const ProxyBox = GetWallRunProxyBox();
+
+	if (!ProxyBox)
+	{
+		return WallRunProxy->IsCollisionEnabled() || MeshComponent->GetCollisionResponseToChannel(ECC_WallRun) != ECR_Block;
+	}
+
+	return !WallRunProxy->IsCollisionEnabled()
+		|| MeshComponent->GetCollisionResponseToChannel(ECC_WallRun) != ECR_Ignore
+		|| !WallRunProxy->GetRelativeLocation().Equals(ProxyBox->Center, Tolerance)
+		|| !WallRunProxy->GetRelativeRotation().Equals(ProxyBox->Rotation, Tolerance)
+		|| !WallRunProxy->GetUnscaledBoxExtent().Equals(FVector(ProxyBox->X, ProxyBox->Y, ProxyBox->Z) * 0.5, Tolerance);
+}
+
+bool AWallrunnableStaticMeshActor::HasMismatchedWallRunProxy() const
+{
+	return WallRunProxy->IsCollisionEnabled() && !GetWallRunProxyBox();
+}
+
+const FKBoxElem* AWallrunnableStaticMeshActor::GetWallRunProxyBox() const
+{
+	if (!bUseWallRunProxy) return nullptr;
+
+	const UStaticMesh* const StaticMesh = GetStaticMeshComponent()->GetStaticMesh();
+	const UBodySetup* const BodySetup = StaticMesh ? StaticMesh->GetBodySetup() : nullptr;
+
+	if (!BodySetup || BodySetup->GetCollisionTraceFlag() == CTF_UseComplexAsSimple) return nullptr;
+
+	/* Anything but a single box, such as the convex hulls of a curved wall, can't be copied into a box without flattening it. */
+	const FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+
+	return AggGeom.GetElementCount() == 1 && AggGeom.BoxElems.Num() == 1 ? &AggGeom.BoxElems[0] : nullptr;
+}
+
+void AWallrunnableStaticMeshActor::UpdateWallRunProxy()
+{
+	UStaticMeshComponent* const MeshComponent = GetStaticMeshComponent();
+
+	/* Only movable mobility carries over to attached components, so match the mesh both ways. */
+	if (WallRunProxy->Mobility != MeshComponent->Mobility)
+	{
+		WallRunProxy->SetMobility(MeshComponent->Mobility);
+	}
+
+	if (const FKBoxElem* const ProxyBox = GetWallRunProxyBox())
+	{
+		/* The proxy is attached to the mesh, so the box's local transform already accounts for the component's scale and rotation. */
+		WallRunProxy->SetRelativeLocationAndRotation(ProxyBox->Center, ProxyBox->Rotation);
+		WallRunProxy->SetBoxExtent(FVector(ProxyBox->X, ProxyBox->Y, ProxyBox->Z) * 0.5, false);
+		WallRunProxy->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		MeshComponent->SetCollisionResponseToChannel(ECC_WallRun, ECR_Ignore);
+	}
+	else
+	{
+		WallRunProxy->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		MeshComponent->SetCollisionResponseToChannel(ECC_WallRun, ECR_Block);
+	}
+
+	/* The surface that answers wall run queries may have changed. */
+	if (HasActorBegunPlay())
+	{
+		if (UWallrunnableRegistrySubsystem* const Registry = GetWorld()->GetSubsystem<UWallrunnableRegistrySubsystem>())
+		{
+			Registry->RegisterActor(this);
+		}
+	}
+}
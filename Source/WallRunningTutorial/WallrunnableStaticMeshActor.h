@@ -7,12 +7,69 @@
 #include "WallrunnableInterface.h"
 #include "WallrunnableStaticMeshActor.generated.h"
 
+class UBoxComponent;
+
+struct FKBoxElem;
+
 /**
- * 
+ * AWallrunnableStaticMeshActor is a static mesh actor that characters can wall run on.
+ * If the mesh's simple collision is a single box, wall run queries are answered by a box proxy copied from it, so they never touch the mesh's other collision.
+ * Any other mesh, such as a curved or angled wall, answers wall run queries with its own simple collision, so the probes follow its actual shape.
  */
 UCLASS()
 class WALLRUNNINGTUTORIAL_API AWallrunnableStaticMeshActor : public AStaticMeshActor, public IWallrunnableInterface
 {
 	GENERATED_BODY()
-	
+
+	/** Box proxy that only responds to the wall run trace channel. Regenerated from the mesh's simple collision box whenever the actor is constructed. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = WallRun, meta = (AllowPrivateAccess = "true"))
+	UBoxComponent* WallRunProxy;
+
+	/** If true, wall run queries use the generated box proxy when the mesh's simple collision is a single box. Other meshes never use the proxy. */
+	UPROPERTY(EditAnywhere, Category = WallRun, meta = (DisplayName = "Use Wall Run Proxy"))
+	bool bUseWallRunProxy = true;
+
+public:
+
+	AWallrunnableStaticMeshActor();
+
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+	virtual void BeginPlay() override;
+
+	/**
+	 * Check if wall run queries against this actor would have to use complex (per-poly) collision.
+	 *
+	 * @return		True if the proxy isn't used and the mesh has no simple collision or uses complex collision as simple.
+	 */
+	bool UsesComplexWallRunCollision() const;
+
+	/**
+	 * Check if the proxy no longer matches the mesh, such as for actors placed before the proxy existed that haven't been reconstructed since.
+	 *
+	 * @return		True if the proxy's shape or the wall run channel routing differs from what UpdateWallRunProxy would generate.
+	 */
+	bool IsWallRunProxyOutOfDate() const;
+
+	/**
+	 * Check if the proxy is in use although the mesh's simple collision isn't a single box, such as for curved walls placed before the proxy followed the mesh's collision.
+	 *
+	 * @return		True if the proxy answers wall run queries for a mesh that it can't represent.
+	 */
+	bool HasMismatchedWallRunProxy() const;
+
+	/** Returns WallRunProxy subobject **/
+	FORCEINLINE UBoxComponent* GetWallRunProxy() const { return WallRunProxy; }
+
+protected:
+
+	/** Fits the proxy to the mesh's simple collision box and routes the wall run trace channel to either the proxy or the mesh. Refreshes the actor's registered surfaces if it has begun play. */
+	virtual void UpdateWallRunProxy();
+
+	/**
+	 * Find the box that the proxy should copy.
+	 *
+	 * @return		The mesh's only simple collision element if it's a box and the proxy is enabled, otherwise null.
+	 */
+	const FKBoxElem* GetWallRunProxyBox() const;
 };
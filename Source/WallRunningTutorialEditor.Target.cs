@@ -11,5 +11,6 @@ public class WallRunningTutorialEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
 		ExtraModuleNames.Add("WallRunningTutorial");
+		ExtraModuleNames.Add("WallRunningTutorialEditor");
 	}
 }
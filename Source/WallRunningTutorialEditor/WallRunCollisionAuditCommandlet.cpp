@@ -0,0 +1,154 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WallRunCollisionAuditCommandlet.h"
+#include <AssetRegistry/ARFilter.h>
+#include <AssetRegistry/IAssetRegistry.h>
+#include <Components/StaticMeshComponent.h>
+#include <Engine/Level.h>
+#include <Engine/StaticMesh.h>
+#include <Engine/World.h>
+#include <UObject/UObjectHash.h>
+#include "WallrunnableStaticMeshActor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogWallRunCollisionAudit, Log, All);
+
+namespace WallRunCollisionAudit
+{
+	/** Collects the wallrunnable actors of a loaded map, loading the ones that are stored in external actor packages. */
+	static void GatherWallrunnableActors(const UWorld* World, TArray<const AWallrunnableStaticMeshActor*>& OutActors)
+	{
+		for (const AActor* const Actor : World->PersistentLevel->Actors)
+		{
+			if (const AWallrunnableStaticMeshActor* const WallrunnableActor = Cast<AWallrunnableStaticMeshActor>(Actor))
+			{
+				OutActors.AddUnique(WallrunnableActor);
+			}
+		}
+
+		/* Maps that use one file per actor, including every World Partition map, only load their actors on demand. */
+		if (!World->PersistentLevel->IsUsingExternalActors()) return;
+
+		FARFilter Filter{};
+		Filter.PackagePaths.Add(*ULevel::GetExternalActorsPath(World->GetPackage()->GetName()));
+		Filter.bRecursivePaths = true;
+		Filter.ClassPaths.Add(AWallrunnableStaticMeshActor::StaticClass()->GetClassPathName());
+		Filter.bRecursiveClasses = true;
+
+		TArray<FAssetData> ActorAssets;
+		IAssetRegistry::GetChecked().GetAssets(Filter, ActorAssets);
+
+		for (const FAssetData& ActorAsset : ActorAssets)
+		{
+			UPackage* const ActorPackage = LoadPackage(nullptr, *ActorAsset.PackageName.ToString(), LOAD_None);
+
+			if (!ActorPackage)
+			{
+				UE_LOG(LogWallRunCollisionAudit, Warning, TEXT("Failed to load actor package '%s'."), *ActorAsset.PackageName.ToString());
+				continue;
+			}
+
+			ForEachObjectWithPackage(ActorPackage, [&OutActors](UObject* Object)
+			{
+				if (const AWallrunnableStaticMeshActor* const WallrunnableActor = Cast<AWallrunnableStaticMeshActor>(Object))
+				{
+					OutActors.AddUnique(WallrunnableActor);
+				}
+
+				return true;
+			}, false);
+		}
+	}
+}
+
+UWallRunCollisionAuditCommandlet::UWallRunCollisionAuditCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UWallRunCollisionAuditCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	TArray<FString> MapPackageNames;
+
+	/* Needed to find maps and external actor packages. */
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+
+	if (const FString* const MapParam = ParamVals.Find(TEXT("Map")))
+	{
+		MapParam->ParseIntoArray(MapPackageNames, TEXT("+"));
+	}
+	else
+	{
+		TArray<FAssetData> MapAssets;
+		AssetRegistry.GetAssetsByClass(UWorld::StaticClass()->GetClassPathName(), MapAssets);
+
+		for (const FAssetData& MapAsset : MapAssets)
+		{
+			const FString PackageName = MapAsset.PackageName.ToString();
+
+			if (PackageName.StartsWith(TEXT("/Game/")))
+			{
+				MapPackageNames.Add(PackageName);
+			}
+		}
+	}
+
+	int32 NumWallrunnableActors = 0;
+	int32 NumComplexCollisionActors = 0;
+	int32 NumOutOfDateProxyActors = 0;
+	int32 NumMismatchedProxyActors = 0;
+
+	for (const FString& MapPackageName : MapPackageNames)
+	{
+		UPackage* const Package = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+		const UWorld* const World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+
+		if (!World || !World->PersistentLevel)
+		{
+			UE_LOG(LogWallRunCollisionAudit, Warning, TEXT("Failed to load map '%s'."), *MapPackageName);
+			continue;
+		}
+
+		TArray<const AWallrunnableStaticMeshActor*> WallrunnableActors;
+		WallRunCollisionAudit::GatherWallrunnableActors(World, WallrunnableActors);
+
+		for (const AWallrunnableStaticMeshActor* const WallrunnableActor : WallrunnableActors)
+		{
+			++NumWallrunnableActors;
+
+			const UStaticMesh* const StaticMesh = WallrunnableActor->GetStaticMeshComponent()->GetStaticMesh();
+
+			/* Mismatched proxies are out of date as well, but flattening a curved or angled wall is worth its own warning. */
+			if (WallrunnableActor->HasMismatchedWallRunProxy())
+			{
+				++NumMismatchedProxyActors;
+				UE_LOG(LogWallRunCollisionAudit, Warning, TEXT("%s: '%s' uses a box proxy, but its mesh's simple collision isn't a single box (mesh '%s'). Re-save the actor to use the mesh's own collision."), *MapPackageName, *WallrunnableActor->GetActorNameOrLabel(), *GetPathNameSafe(StaticMesh));
+			}
+			else if (WallrunnableActor->IsWallRunProxyOutOfDate())
+			{
+				++NumOutOfDateProxyActors;
+				UE_LOG(LogWallRunCollisionAudit, Warning, TEXT("%s: '%s' has an out of date wall run proxy. Re-save the actor to regenerate it."), *MapPackageName, *WallrunnableActor->GetActorNameOrLabel());
+			}
+
+			if (WallrunnableActor->UsesComplexWallRunCollision())
+			{
+				++NumComplexCollisionActors;
+				UE_LOG(LogWallRunCollisionAudit, Warning, TEXT("%s: '%s' uses complex collision for wall running (mesh '%s')."), *MapPackageName, *WallrunnableActor->GetActorNameOrLabel(), *GetPathNameSafe(StaticMesh));
+			}
+		}
+	}
+
+	UE_LOG(LogWallRunCollisionAudit, Display, TEXT("Audited %d map(s): %d of %d wallrunnable actor(s) use complex collision, %d have a box proxy that doesn't fit their mesh, %d have an out of date proxy."),
+		MapPackageNames.Num(), NumComplexCollisionActors, NumWallrunnableActors, NumMismatchedProxyActors, NumOutOfDateProxyActors);
+
+	return 0;
+}
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "WallRunCollisionAuditCommandlet.generated.h"
+
+/**
+ * Lists every AWallrunnableStaticMeshActor whose wall run queries still fall back to complex collision, whose box proxy flattens a mesh that isn't a box,
+ * or whose proxy no longer matches its mesh.
+ * Actors stored in external actor packages are loaded for the audit.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=WallRunCollisionAudit [-Map=/Game/Path/MapA+/Game/Path/MapB]
+ * Without -Map, every map under /Game is audited.
+ */
+UCLASS()
+class UWallRunCollisionAuditCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UWallRunCollisionAuditCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,199 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WallRunTelemetryAggregateCommandlet.h"
+#include <HAL/FileManager.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include "CustomCharacterMovementComponent.h"
+#include "WallRunTelemetry.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogWallRunTelemetryAggregate, Log, All);
+
+namespace WallRunTelemetryAggregate
+{
+	/** Map region that heatmap values are accumulated in. */
+	using FCell = FIntPoint;
+
+	static FCell GetCell(const FVector3f& Location, const float CellSize)
+	{
+		return FCell(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+	}
+
+	static void AddToHistogram(TMap<int32, int32>& Histogram, const float Value, const float BinSize)
+	{
+		++Histogram.FindOrAdd(FMath::FloorToInt(Value / BinSize));
+	}
+
+	static bool SaveHistogram(const FString& FilePath, const TMap<int32, int32>& Histogram, const float BinSize)
+	{
+		TArray<int32> Bins;
+		Histogram.GetKeys(Bins);
+		Bins.Sort();
+
+		FString Csv = TEXT("BinStart,BinEnd,Count\n");
+
+		for (const int32 Bin : Bins)
+		{
+			Csv += FString::Printf(TEXT("%.3f,%.3f,%d\n"), Bin * BinSize, (Bin + 1) * BinSize, Histogram[Bin]);
+		}
+
+		return FFileHelper::SaveStringToFile(Csv, *FilePath);
+	}
+
+	static bool SaveHeatmap(const FString& FilePath, const TMap<FCell, float>& Heatmap, const float CellSize)
+	{
+		FString Csv = TEXT("MinX,MinY,MaxX,MaxY,Value\n");
+
+		for (const TPair<FCell, float>& Cell : Heatmap)
+		{
+			Csv += FString::Printf(TEXT("%.0f,%.0f,%.0f,%.0f,%.3f\n"), Cell.Key.X * CellSize, Cell.Key.Y * CellSize, (Cell.Key.X + 1) * CellSize, (Cell.Key.Y + 1) * CellSize, Cell.Value);
+		}
+
+		return FFileHelper::SaveStringToFile(Csv, *FilePath);
+	}
+}
+
+UWallRunTelemetryAggregateCommandlet::UWallRunTelemetryAggregateCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UWallRunTelemetryAggregateCommandlet::Main(const FString& Params)
+{
+	using namespace WallRunTelemetryAggregate;
+
+	FString Directory = FWallRunTelemetry::GetDefaultDirectory();
+	FString OutputDirectory;
+	float CellSize = 1000.0f;
+	float DurationBinSize = 0.25f;
+	float DistanceBinSize = 100.0f;
+
+	FParse::Value(*Params, TEXT("Dir="), Directory);
+	FParse::Value(*Params, TEXT("CellSize="), CellSize);
+	FParse::Value(*Params, TEXT("DurationBin="), DurationBinSize);
+	FParse::Value(*Params, TEXT("DistanceBin="), DistanceBinSize);
+
+	if (!FParse::Value(*Params, TEXT("Out="), OutputDirectory))
+	{
+		OutputDirectory = FPaths::Combine(Directory, TEXT("Aggregate"));
+	}
+
+	if (CellSize <= 0.0f || DurationBinSize <= 0.0f || DistanceBinSize <= 0.0f)
+	{
+		UE_LOG(LogWallRunTelemetryAggregate, Error, TEXT("CellSize, DurationBin and DistanceBin must be greater than zero."));
+		return 1;
+	}
+
+	TArray<FString> FileNames;
+	IFileManager::Get().FindFiles(FileNames, *FPaths::Combine(Directory, TEXT("*.wrtl")), true, false);
+
+	TMap<int32, int32> DurationHistogram;
+	TMap<int32, int32> DistanceHistogram;
+	TMap<FCell, float> WallRunStartHeatmap;
+	TMap<FCell, float> CooldownHeatmap;
+	int32 CornersReached[ECT_MAX]{};
+	int32 CornerTurnsStarted[ECT_MAX]{};
+	int32 CornerTurnsCompleted[ECT_MAX]{};
+	int64 NumRecords = 0;
+
+	for (const FString& FileName : FileNames)
+	{
+		const FString FilePath = FPaths::Combine(Directory, FileName);
+
+		TArray<uint8> FileData;
+
+		if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+		{
+			UE_LOG(LogWallRunTelemetryAggregate, Warning, TEXT("Failed to read '%s'."), *FilePath);
+			continue;
+		}
+
+		FWallRunTelemetryFileHeader Header{};
+
+		if (FileData.Num() < sizeof(Header))
+		{
+			UE_LOG(LogWallRunTelemetryAggregate, Warning, TEXT("Skipping '%s': file is too small."), *FilePath);
+			continue;
+		}
+
+		FMemory::Memcpy(&Header, FileData.GetData(), sizeof(Header));
+
+		if (Header.Magic != WallRunTelemetryMagic || Header.Version != WallRunTelemetryVersion || Header.RecordSize != sizeof(FWallRunTelemetryRecord))
+		{
+			UE_LOG(LogWallRunTelemetryAggregate, Warning, TEXT("Skipping '%s': unsupported telemetry format."), *FilePath);
+			continue;
+		}
+
+		/* A file that was still being written may end in a partial record, which is ignored. */
+		const int32 FileNumRecords = (FileData.Num() - sizeof(Header)) / sizeof(FWallRunTelemetryRecord);
+		const uint8* RecordData = FileData.GetData() + sizeof(Header);
+
+		for (int32 Index = 0; Index < FileNumRecords; ++Index, RecordData += sizeof(FWallRunTelemetryRecord))
+		{
+			FWallRunTelemetryRecord Record{};
+			FMemory::Memcpy(&Record, RecordData, sizeof(Record));
+
+			const int32 CornerType = FMath::Min<int32>(Record.Detail, ECT_MAX - 1);
+
+			switch (Record.Event)
+			{
+			case EWallRunTelemetryEvent::WallRunBegin:
+				WallRunStartHeatmap.FindOrAdd(GetCell(Record.Location, CellSize)) += 1.0f;
+				break;
+
+			case EWallRunTelemetryEvent::WallRunEnd:
+				AddToHistogram(DurationHistogram, Record.Value0, DurationBinSize);
+				AddToHistogram(DistanceHistogram, Record.Value1, DistanceBinSize);
+				break;
+
+			case EWallRunTelemetryEvent::CooldownEnd:
+				CooldownHeatmap.FindOrAdd(GetCell(Record.Location, CellSize)) += Record.Value0;
+				break;
+
+			case EWallRunTelemetryEvent::CornerTurnBegin:
+				++CornersReached[CornerType];
+				CornerTurnsStarted[CornerType] += (Record.Value0 > 0.0f) ? 1 : 0;
+				break;
+
+			case EWallRunTelemetryEvent::CornerTurnEnd:
+				++CornerTurnsCompleted[CornerType];
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		NumRecords += FileNumRecords;
+	}
+
+	FString CornersCsv = TEXT("CornerType,Reached,TurnsStarted,TurnsCompleted,SuccessRate\n");
+
+	for (int32 CornerType = 0; CornerType < ECT_MAX; ++CornerType)
+	{
+		const float SuccessRate = CornersReached[CornerType] > 0 ? static_cast<float>(CornerTurnsCompleted[CornerType]) / CornersReached[CornerType] : 0.0f;
+		CornersCsv += FString::Printf(TEXT("%s,%d,%d,%d,%.4f\n"), CornerType == ECT_Inner ? TEXT("Inner") : TEXT("Outer"), CornersReached[CornerType], CornerTurnsStarted[CornerType], CornerTurnsCompleted[CornerType], SuccessRate);
+	}
+
+	IFileManager::Get().MakeDirectory(*OutputDirectory, true);
+
+	const bool bSaved = SaveHistogram(FPaths::Combine(OutputDirectory, TEXT("Durations.csv")), DurationHistogram, DurationBinSize)
+		&& SaveHistogram(FPaths::Combine(OutputDirectory, TEXT("Distances.csv")), DistanceHistogram, DistanceBinSize)
+		&& FFileHelper::SaveStringToFile(CornersCsv, *FPaths::Combine(OutputDirectory, TEXT("Corners.csv")))
+		&& SaveHeatmap(FPaths::Combine(OutputDirectory, TEXT("WallRunStarts.csv")), WallRunStartHeatmap, CellSize)
+		&& SaveHeatmap(FPaths::Combine(OutputDirectory, TEXT("CooldownTime.csv")), CooldownHeatmap, CellSize);
+
+	if (!bSaved)
+	{
+		UE_LOG(LogWallRunTelemetryAggregate, Error, TEXT("Failed to write aggregates to '%s'."), *OutputDirectory);
+		return 1;
+	}
+
+	UE_LOG(LogWallRunTelemetryAggregate, Display, TEXT("Aggregated %lld record(s) from %d file(s) into '%s'."), NumRecords, FileNames.Num(), *OutputDirectory);
+
+	return 0;
+}
@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "WallRunTelemetryAggregateCommandlet.generated.h"
+
+/**
+ * Aggregates wall run telemetry files into CSV histograms and heatmaps.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=WallRunTelemetryAggregate [-Dir=<TelemetryDir>] [-Out=<OutputDir>] [-CellSize=1000] [-DurationBin=0.25] [-DistanceBin=100]
+ *
+ * Outputs:
+ *   Durations.csv			Histogram of wall run durations in seconds.
+ *   Distances.csv			Histogram of distance travelled per wall run.
+ *   Corners.csv				Corner turn attempts, completions and success rates per corner type.
+ *   WallRunStarts.csv		Heatmap of wall run starts per map region.
+ *   CooldownTime.csv		Heatmap of seconds that surfaces spent on cooldown, by the map region where each cooldown started.
+ */
+UCLASS()
+class UWallRunTelemetryAggregateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UWallRunTelemetryAggregateCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};